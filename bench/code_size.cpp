@@ -0,0 +1,29 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+// Code-size workload for the README table: run `bench/code_size.sh` and compare the `.text` of this translation unit
+
+#include "fixed_vector.hpp"
+#include <string>
+
+// One handler per capacity, as an application with many differently-sized vectors would have
+template <typename T, size_t N>
+[[gnu::noinline]] bool work(fixed_vector<T, N>& v, fixed_vector<T, N>& w, const T& x, size_t pos) {
+    v.push_back(x);
+    v.emplace(pos, x);
+    w = v;
+    (void)v.pop_front();
+    v.swap(w);
+    w = std::move(v);
+    return v == w && v[pos] == x;
+}
+
+template <typename T, size_t N>
+bool one(const T& x) { fixed_vector<T, N> v, w; return work(v, w, x, 0); }
+
+template <typename T, size_t... Ns>
+bool all(const T& x, std::index_sequence<Ns...>) { return (one<T, (Ns + 1) * 12>(x) ^ ...); }
+
+bool run_string(const std::string& s) { return all(s, std::make_index_sequence<20>{}); }
+bool run_int(int i) { return all(i, std::make_index_sequence<20>{}); }
@@ -0,0 +1,24 @@
+#!/bin/sh
+# Print the .text size of bench/code_size.cpp at -O2 and -Os, the numbers in the README "Code size" table.
+#
+# Usage: bench/code_size.sh [git revision]
+# With a revision, fixed_vector.hpp is taken from that commit instead of the working tree, e.g. `deeab3d^` for the
+# "before" column. Set CXX to pick the compiler; the table was measured with GCC 12.
+set -eu
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+cxx=${CXX:-g++}
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+if [ $# -gt 0 ]; then
+    git -C "$root" show "$1:fixed_vector.hpp" > "$work/fixed_vector.hpp"
+    include=$work
+else
+    include=$root
+fi
+
+for opt in -O2 -Os; do
+    "$cxx" -std=c++20 "$opt" -I"$include" -c "$root/bench/code_size.cpp" -o "$work/code_size.o"
+    printf '%s\t%s bytes\n' "$opt" "$(size -A "$work/code_size.o" | awk '$1 ~ /^\.text/ { s += $2 } END { print s }')"
+done
@@ -0,0 +1,133 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+// Throughput of `fixed_priority_queue` against `std::priority_queue<T, std::vector<T>>`: run `bench/priority_queue.sh`
+//
+// Every queue holds `n` timers, ordered so that the earliest deadline is on top, and then performs a number of
+// reschedules: the earliest timer is taken off and put back with a later deadline. The standard queue does that with
+// `pop()` and `push()`. `fixed_priority_queue` is timed with the same `pop()` and `push()` pair, and with
+// `replace_top()`, which is what a timer wheel or an order book uses it for. Each figure is the best of several runs
+
+#include "fixed_priority_queue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace {
+    /// @brief A timer: 16 bytes, ordered by deadline only
+    struct timer {
+        std::uint64_t deadline;
+        std::uint64_t id;
+    };
+
+    /// @brief Put the earliest deadline on top
+    struct later {
+        bool operator()(const timer& a, const timer& b) const noexcept { return a.deadline > b.deadline; }
+    };
+
+    constexpr size_t OPS = 1 << 21;
+    constexpr int RUNS = 7;
+
+    /// @brief The initial timers and the delay each reschedule adds, shared by every queue for one size
+    struct workload {
+        std::vector<timer> initial;
+        std::vector<std::uint32_t> delays;
+
+        explicit workload(size_t n) : initial(n), delays(OPS) {
+            std::mt19937_64 rng(n);
+            for (size_t i = 0; i < n; ++i) this->initial[i] = {rng() % (n * 16), i};
+            for (std::uint32_t& d : this->delays) d = static_cast<std::uint32_t>(rng() % (n * 16)) + 1;
+        }
+    };
+
+    /// @brief Keeps results alive so the reschedule loops are not optimized away
+    volatile std::uint64_t sink;
+
+    /// @brief Get the best time of `RUNS` runs of `f` in nanoseconds per reschedule
+    template <typename F>
+    double best_of(F f) {
+        double best = 1e300;
+        for (int run = 0; run < RUNS; ++run) {
+            const auto start = std::chrono::steady_clock::now();
+            sink = f();
+            const std::chrono::duration<double, std::nano> took = std::chrono::steady_clock::now() - start;
+            best = std::min(best, took.count() / OPS);
+        }
+        return best;
+    }
+
+    double std_pop_push(const workload& w) {
+        return best_of([&] {
+            std::priority_queue<timer, std::vector<timer>, later> q(later(), w.initial);
+            for (const std::uint32_t d : w.delays) {
+                timer t = q.top();
+                q.pop();
+                t.deadline += d;
+                q.push(t);
+            }
+            return q.top().id;
+        });
+    }
+
+    template <size_t N, size_t ARITY>
+    double fixed_pop_push(const workload& w) {
+        // Several hundred kilobytes: kept off the stack
+        using queue = fixed_priority_queue<timer, N, later, ARITY>;
+        const auto p = std::make_unique<queue>();
+        queue& q = *p;
+        return best_of([&] {
+            q.clear();
+            q.push_range(w.initial.begin(), w.initial.end());
+            for (const std::uint32_t d : w.delays) {
+                timer t = q.pop();
+                t.deadline += d;
+                q.push(t);
+            }
+            return q.top().id;
+        });
+    }
+
+    template <size_t N, size_t ARITY>
+    double fixed_replace_top(const workload& w) {
+        using queue = fixed_priority_queue<timer, N, later, ARITY>;
+        const auto p = std::make_unique<queue>();
+        queue& q = *p;
+        return best_of([&] {
+            q.clear();
+            q.push_range(w.initial.begin(), w.initial.end());
+            for (const std::uint32_t d : w.delays) {
+                timer t = q.top();
+                t.deadline += d;
+                (void)q.replace_top(t);
+            }
+            return q.top().id;
+        });
+    }
+
+    template <size_t N>
+    void run() {
+        const workload w(N);
+        const double base = std_pop_push(w);
+        const double binary = fixed_pop_push<N, 2>(w);
+        const double quad = fixed_pop_push<N, 4>(w);
+        const double replace = fixed_replace_top<N, 4>(w);
+        std::printf("%8zu %10.1f %10.1f (%4.2fx) %10.1f (%4.2fx) %10.1f (%4.2fx)\n", N, base, binary, base / binary,
+                    quad, base / quad, replace, base / replace);
+    }
+}
+
+int main() {
+    std::printf("%8s %10s %19s %19s %19s\n", "timers", "std", "fixed 2-ary", "fixed 4-ary", "4-ary replace_top");
+    std::puts("         ns per reschedule, (speedup over std::priority_queue)");
+    run<1 << 10>();
+    run<1 << 14>();
+    run<1 << 18>();
+    return 0;
+}
@@ -0,0 +1,14 @@
+#!/bin/sh
+# Build and run bench/priority_queue.cpp, the numbers in the README "Priority queue" table.
+#
+# Usage: bench/priority_queue.sh [extra compiler flags]
+# Compiled with -O2 by default. Set CXX to pick the compiler; the table was measured with GCC 12.
+set -eu
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+cxx=${CXX:-g++}
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+"$cxx" -std=c++20 -O2 -DNDEBUG "$@" -I"$root" "$root/bench/priority_queue.cpp" -o "$work/priority_queue"
+"$work/priority_queue"
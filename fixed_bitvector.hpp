@@ -0,0 +1,364 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef FIXED_BITVECTOR_HPP
+#define FIXED_BITVECTOR_HPP
+
+#include "fixed_vector.hpp"
+
+#include <bit>
+#include <span>
+
+/**
+ * @class fixed_bitvector
+ * @brief A bit-packed `fixed_vector<bool, N>`: 64 flags per word, no dynamic memory allocation
+ *
+ * Flags are pushed, popped and indexed like in `fixed_vector`, with `operator[]` returning a proxy reference. Counting,
+ * searching and the bitwise operators work a whole word at a time. After `build_rank()`, `rank()` is O(1) and
+ * `select()` is logarithmic in the number of 512-bit blocks, using a directory of per-block counts. Any modification
+ * invalidates the directory, and until it is rebuilt both count the words directly. The const functions never write
+ * to the bit vector, so they are safe to call from several threads at once
+ * @tparam N The compile-time capacity in bits
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types
+ */
+template <size_t N, typename Policy = fixed_vector_policy::default_policy>
+class fixed_bitvector {
+    static_assert(N > 0, "Capacity cannot be 0");
+
+    using word_type = std::uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr size_t WORDS = (N + WORD_BITS - 1) / WORD_BITS;
+    /// @brief The number of words covered by one entry of the rank directory
+    static constexpr size_t BLOCK_WORDS = 8;
+    static constexpr size_t BLOCKS = (WORDS + BLOCK_WORDS - 1) / BLOCK_WORDS;
+
+public:
+    /// @brief The type used to store the logical size: the smallest unsigned type that can hold `N`
+    using size_type = fixed_vector_detail::smallest_size_t<N>;
+    using value_type = bool;
+    using const_reference = bool;
+
+    /// @brief Returned by the `find` functions and `select()` when there is no such bit
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @class reference
+     * @brief A proxy for a single bit, returned by the mutable `operator[]`
+     */
+    class reference {
+        friend class fixed_bitvector;
+
+        fixed_bitvector* _vec;
+        size_t _pos;
+
+        constexpr reference(fixed_bitvector* vec, size_t pos) noexcept : _vec(vec), _pos(pos) {}
+
+    public:
+        constexpr reference(const reference&) noexcept = default;
+
+        /// @brief Set the bit to `val`
+        constexpr reference& operator= (bool val) noexcept {
+            this->_vec->unchecked_set(this->_pos, val);
+            return *this;
+        }
+
+        /// @brief Set the bit to the value of another bit
+        constexpr reference& operator= (const reference& r) noexcept { return *this = static_cast<bool>(r); }
+
+        /// @brief Read the bit
+        constexpr operator bool() const noexcept { return this->_vec->unchecked_test(this->_pos); }
+
+        /// @brief Read the inverse of the bit
+        constexpr bool operator~ () const noexcept { return !static_cast<bool>(*this); }
+
+        /// @brief Invert the bit
+        constexpr reference& flip() noexcept {
+            this->_vec->unchecked_set(this->_pos, !static_cast<bool>(*this));
+            return *this;
+        }
+    };
+
+private:
+    /// @brief The current logical size in bits
+    size_type _current_size;
+    /// @brief Whether `_block_rank` is out of date
+    bool _rank_dirty;
+    /// @brief The packed bits. Words past `used_words()` are uninitialized and bits past `_current_size` in the used
+    /// words are always 0, so whole words can be counted and combined without masking
+    fixed_vector_detail::storage<word_type, WORDS> _words;
+    /// @brief The number of set bits before each 512-bit block, valid while `_rank_dirty` is false
+    fixed_vector_detail::storage<size_type, BLOCKS> _block_rank;
+
+    /// @brief The number of words holding at least one bit of the logical contents
+    constexpr size_t used_words() const noexcept { return (this->_current_size + WORD_BITS - 1) / WORD_BITS; }
+
+    constexpr word_type* words() noexcept { return this->_words.data(); }
+    constexpr const word_type* words() const noexcept { return this->_words.data(); }
+
+    /// @brief Clear the bits of the last used word that lie past the logical size
+    constexpr void mask_tail() noexcept {
+        const size_t rem = this->_current_size % WORD_BITS;
+        if (rem != 0) this->words()[this->used_words() - 1] &= (word_type{1} << rem) - 1;
+    }
+
+    /// @brief Read bit `pos`
+    /// @warning DOES NOT BOUNDS CHECK
+    constexpr bool unchecked_test(size_t pos) const noexcept {
+        return (this->words()[pos / WORD_BITS] >> (pos % WORD_BITS)) & 1;
+    }
+
+    /// @brief Write bit `pos`
+    /// @warning DOES NOT BOUNDS CHECK
+    constexpr void unchecked_set(size_t pos, bool val) noexcept {
+        const word_type mask = word_type{1} << (pos % WORD_BITS);
+        word_type& word = this->words()[pos / WORD_BITS];
+        word = val ? (word | mask) : (word & ~mask);
+        this->_rank_dirty = true;
+    }
+
+    /// @brief Get the number of set bits before block `b`, from the directory if it is up to date
+    constexpr size_t block_rank(size_t b) const noexcept {
+        if (!this->_rank_dirty) return this->_block_rank.data()[b];
+        size_t total = 0;
+        for (size_t w = 0; w < std::min(this->used_words(), b * BLOCK_WORDS); ++w)
+            total += std::popcount(this->words()[w]);
+        return total;
+    }
+
+    /// @brief Get the index of the first set bit in word `w` or later, or `npos`
+    constexpr size_t find_from_word(size_t w) const noexcept {
+        for (const size_t used = this->used_words(); w < used; ++w) {
+            if (this->words()[w] != 0) return w * WORD_BITS + std::countr_zero(this->words()[w]);
+        }
+        return npos;
+    }
+
+    /// @brief Apply `op` to every used word of this and `v`, treating words past the end of `v` as 0
+    template <typename Op>
+    constexpr fixed_bitvector& combine(const fixed_bitvector& v, Op op) noexcept {
+        const size_t used = this->used_words();
+        const size_t common = std::min(used, v.used_words());
+        for (size_t w = 0; w < common; ++w) this->words()[w] = op(this->words()[w], v.words()[w]);
+        for (size_t w = common; w < used; ++w) this->words()[w] = op(this->words()[w], word_type{0});
+        this->mask_tail();
+        this->_rank_dirty = true;
+        return *this;
+    }
+
+public:
+    /// @brief Default constructor. Initial size will be 0
+    constexpr fixed_bitvector() : _current_size(0), _rank_dirty(true) {}
+
+    /// @brief Construct `count` bits, all set to `val`
+    constexpr fixed_bitvector(size_t count, bool val) : _current_size(0), _rank_dirty(true) {
+        fixed_vector_detail::check<Policy>(count > N, fixed_vector_error::too_many, "Cannot construct", count, N);
+        this->_current_size = static_cast<size_type>(count);
+        for (size_t w = 0; w < this->used_words(); ++w) this->words()[w] = val ? ~word_type{0} : word_type{0};
+        this->mask_tail();
+    }
+
+    /// @brief Initializer list constructor: allows initialization of `fixed_bitvector` using curly brace lists
+    constexpr fixed_bitvector(std::initializer_list<bool> init_list) : fixed_bitvector(init_list.size(), false) {
+        size_t pos = 0;
+        for (const bool val : init_list) {
+            if (val) this->words()[pos / WORD_BITS] |= word_type{1} << (pos % WORD_BITS);
+            ++pos;
+        }
+    }
+
+    /// @brief Get the maximum number of bits
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+
+    /// @brief Get the current logical size in bits
+    [[nodiscard]] constexpr size_t size() const noexcept { return this->_current_size; }
+
+    /// @brief Whether the bit vector holds no bits
+    [[nodiscard]] constexpr bool empty() const noexcept { return this->_current_size == 0; }
+
+    /// @brief Clear the bit vector logical contents
+    constexpr void clear() noexcept {
+        this->_current_size = 0;
+        this->_rank_dirty = true;
+    }
+
+    /**
+     * @brief Recount the set bits before each 512-bit block, making `rank()` O(1) and `select()` logarithmic until the
+     * next modification
+     */
+    constexpr void build_rank() noexcept {
+        size_t total = 0;
+        const size_t used = this->used_words();
+        for (size_t b = 0; b < BLOCKS; ++b) {
+            this->_block_rank.data()[b] = static_cast<size_type>(total);
+            const size_t end = std::min(used, (b + 1) * BLOCK_WORDS);
+            for (size_t w = b * BLOCK_WORDS; w < end; ++w) total += std::popcount(this->words()[w]);
+        }
+        this->_rank_dirty = false;
+    }
+
+    /// @brief Get the packed words holding the logical contents. Bits past `size()` in the last word are 0
+    [[nodiscard]] constexpr std::span<const word_type> data() const noexcept {
+        return std::span<const word_type>(this->words(), this->used_words());
+    }
+
+    /// @brief Add a bit to the end, increasing the logical size by 1
+    constexpr void push_back(bool val) {
+        fixed_vector_detail::check<Policy>(this->_current_size == N, fixed_vector_error::full, "Cannot push back", N);
+        const size_t pos = this->_current_size;
+        // Entering a new word: it is uninitialized until now
+        if (pos % WORD_BITS == 0) this->words()[pos / WORD_BITS] = 0;
+        this->_current_size = static_cast<size_type>(pos + 1);
+        this->unchecked_set(pos, val);
+    }
+
+    /// @brief Remove a bit from the end, decreasing the logical size by 1
+    /// @return The bit previously at the back
+    constexpr bool pop_back() {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop back");
+        const size_t pos = this->_current_size - 1;
+        const bool val = this->unchecked_test(pos);
+        this->unchecked_set(pos, false);
+        this->_current_size = static_cast<size_type>(pos);
+        return val;
+    }
+
+    /// @brief Allow square-bracket indexing like a `std::vector<bool>`
+    constexpr reference operator[](size_t pos) {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->_current_size);
+        return reference(this, pos);
+    }
+
+    /// @brief Allow const square-bracket indexing like a `std::vector<bool>`
+    constexpr bool operator[](size_t pos) const {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->_current_size);
+        return this->unchecked_test(pos);
+    }
+
+    /// @brief Set every bit to `val`
+    constexpr void set(bool val = true) noexcept {
+        for (size_t w = 0; w < this->used_words(); ++w) this->words()[w] = val ? ~word_type{0} : word_type{0};
+        this->mask_tail();
+        this->_rank_dirty = true;
+    }
+
+    /// @brief Clear every bit
+    constexpr void reset() noexcept { this->set(false); }
+
+    /// @brief Invert every bit
+    constexpr void flip() noexcept {
+        for (size_t w = 0; w < this->used_words(); ++w) this->words()[w] = ~this->words()[w];
+        this->mask_tail();
+        this->_rank_dirty = true;
+    }
+
+    /// @brief Get the number of set bits
+    [[nodiscard]] constexpr size_t count() const noexcept {
+        size_t total = 0;
+        for (size_t w = 0; w < this->used_words(); ++w) total += std::popcount(this->words()[w]);
+        return total;
+    }
+
+    /// @brief Whether any bit is set
+    [[nodiscard]] constexpr bool any() const noexcept { return this->find_first() != npos; }
+
+    /// @brief Whether no bit is set
+    [[nodiscard]] constexpr bool none() const noexcept { return !this->any(); }
+
+    /// @brief Whether every bit is set. True for an empty bit vector
+    [[nodiscard]] constexpr bool all() const noexcept { return this->count() == this->_current_size; }
+
+    /// @brief Get the index of the first set bit, or `npos`
+    [[nodiscard]] constexpr size_t find_first() const noexcept { return this->find_from_word(0); }
+
+    /// @brief Get the index of the first set bit after `pos`, or `npos`. `find_next(npos)` is `npos`
+    [[nodiscard]] constexpr size_t find_next(size_t pos) const noexcept {
+        if (pos >= this->_current_size || ++pos == this->_current_size) return npos;
+        const word_type rest = this->words()[pos / WORD_BITS] >> (pos % WORD_BITS);
+        if (rest != 0) return pos + std::countr_zero(rest);
+        return this->find_from_word(pos / WORD_BITS + 1);
+    }
+
+    /// @brief Get the number of set bits in `[0, pos)`. O(1) after `build_rank()`, linear in `pos` otherwise
+    /// @param pos Must not be larger than `size()`
+    [[nodiscard]] constexpr size_t rank(size_t pos) const {
+        fixed_vector_detail::check<Policy>(pos > this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot rank", pos, this->_current_size);
+        const size_t word = pos / WORD_BITS;
+        if (word == WORDS) return this->count();
+        size_t total = this->block_rank(word / BLOCK_WORDS);
+        for (size_t w = word / BLOCK_WORDS * BLOCK_WORDS; w < word; ++w) total += std::popcount(this->words()[w]);
+        if (pos % WORD_BITS != 0)
+            total += std::popcount(this->words()[word] & ((word_type{1} << (pos % WORD_BITS)) - 1));
+        return total;
+    }
+
+    /**
+     * @brief Get the index of the set bit with rank `k`, i.e. the (k+1)-th set bit, or `npos` if there are not that many
+     *
+     * Logarithmic in the number of blocks after `build_rank()`, a linear scan of the words otherwise
+     */
+    [[nodiscard]] constexpr size_t select(size_t k) const noexcept {
+        const size_t used = this->used_words();
+        if (used == 0) return npos;
+        size_t lo = 0, end = used;
+        if (!this->_rank_dirty) {
+            // The last block that starts with at most `k` set bits before it
+            size_t hi = (used - 1) / BLOCK_WORDS;
+            while (lo < hi) {
+                const size_t mid = (lo + hi + 1) / 2;
+                if (this->_block_rank.data()[mid] <= k) lo = mid;
+                else hi = mid - 1;
+            }
+            k -= this->_block_rank.data()[lo];
+            end = std::min(used, (lo + 1) * BLOCK_WORDS);
+        }
+        for (size_t w = lo * BLOCK_WORDS; w < end; ++w) {
+            word_type word = this->words()[w];
+            const size_t ones = std::popcount(word);
+            if (k < ones) {
+                for (; k > 0; --k) word &= word - 1;
+                return w * WORD_BITS + std::countr_zero(word);
+            }
+            k -= ones;
+        }
+        return npos;
+    }
+
+    /// @brief Intersect with `v` word by word. Bits past the end of `v` count as 0, the size is unchanged
+    constexpr fixed_bitvector& operator&= (const fixed_bitvector& v) noexcept {
+        return this->combine(v, [](word_type a, word_type b) { return a & b; });
+    }
+
+    /// @brief Unite with `v` word by word. Bits of `v` past the size of this bit vector are dropped
+    constexpr fixed_bitvector& operator|= (const fixed_bitvector& v) noexcept {
+        return this->combine(v, [](word_type a, word_type b) { return a | b; });
+    }
+
+    /// @brief Exclusive-or with `v` word by word. Bits of `v` past the size of this bit vector are dropped
+    constexpr fixed_bitvector& operator^= (const fixed_bitvector& v) noexcept {
+        return this->combine(v, [](word_type a, word_type b) { return a ^ b; });
+    }
+
+    /// @brief Word-parallel intersection, sized like `a`
+    friend constexpr fixed_bitvector operator& (fixed_bitvector a, const fixed_bitvector& b) noexcept { return a &= b; }
+
+    /// @brief Word-parallel union, sized like `a`
+    friend constexpr fixed_bitvector operator| (fixed_bitvector a, const fixed_bitvector& b) noexcept { return a |= b; }
+
+    /// @brief Word-parallel exclusive-or, sized like `a`
+    friend constexpr fixed_bitvector operator^ (fixed_bitvector a, const fixed_bitvector& b) noexcept { return a ^= b; }
+
+    /// @brief Allow two `fixed_bitvector`s to be compared using `==`
+    constexpr bool operator== (const fixed_bitvector& v) const noexcept {
+        if (this->_current_size != v._current_size) return false;
+        for (size_t w = 0; w < this->used_words(); ++w) {
+            if (this->words()[w] != v.words()[w]) return false;
+        }
+        return true;
+    }
+};
+
+#endif //FIXED_BITVECTOR_HPP
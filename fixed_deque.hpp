@@ -0,0 +1,504 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef FIXED_DEQUE_HPP
+#define FIXED_DEQUE_HPP
+
+#include "fixed_vector.hpp"
+
+#include <optional>
+#include <span>
+
+/**
+ * @class fixed_deque
+ * @brief Allows functionality like `std::deque<T>` but with no dynamic memory allocation
+ *
+ * Same storage model as `fixed_vector<T, CAPACITY>`, but the elements form a ring buffer, so pushing and popping at
+ * either end is O(1) instead of shifting every element. When `CAPACITY` is a power of two, wrapping an index around the
+ * end of the buffer is a single mask
+ * @tparam T The data type to store in the fixed deque
+ * @tparam CAPACITY The compile-time capacity of the fixed deque
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types
+ */
+template <typename T, size_t CAPACITY, typename Policy = fixed_vector_policy::default_policy>
+class fixed_deque {
+    static_assert(CAPACITY > 0, "Capacity cannot be 0");
+
+public:
+    /// @brief The type used to store the logical size and head position
+    using size_type = fixed_vector_detail::smallest_size_t<CAPACITY>;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    /// @brief Whether wrapping can be done by masking with `CAPACITY - 1`
+    static constexpr bool POWER_OF_TWO = (CAPACITY & (CAPACITY - 1)) == 0;
+
+    /// @brief The physical slot holding the logical front element
+    size_type _head;
+    /// @brief The current logical size of the fixed deque
+    size_type _current_size;
+    /// @brief Uninitialized storage for the elements. Only the slots in the live ring hold objects
+    fixed_vector_detail::storage<T, CAPACITY> _buf;
+
+    /// @brief Wrap a physical index in `[0, 2 * CAPACITY)` back into `[0, CAPACITY)`
+    static constexpr size_t wrap(size_t pos) noexcept {
+        if constexpr (POWER_OF_TWO) return pos & (CAPACITY - 1);
+        else return pos >= CAPACITY ? pos - CAPACITY : pos;
+    }
+
+    /// @brief Get a pointer to the physical storage slot at `pos`, which may or may not hold a live object
+    T* slot(size_t pos) noexcept { return this->_buf.data() + pos; }
+
+    /// @brief Get a const pointer to the physical storage slot at `pos`, which may or may not hold a live object
+    const T* slot(size_t pos) const noexcept { return this->_buf.data() + pos; }
+
+    /// @brief Get a pointer to the logical element at `pos`
+    T* at_logical(size_t pos) noexcept { return this->slot(wrap(this->_head + pos)); }
+
+    /// @brief Get a const pointer to the logical element at `pos`
+    const T* at_logical(size_t pos) const noexcept { return this->slot(wrap(this->_head + pos)); }
+
+    /**
+     * @brief Copy or move every element of `d` into this empty deque, laying them out from slot 0
+     *
+     * If an element throws, the elements already built are destroyed before rethrowing: the copy and move constructors
+     * call this, and a constructor that throws never reaches the destructor
+     */
+    template <typename Deque>
+    void construct_from(Deque&& d) {
+        constexpr bool MOVE = std::is_rvalue_reference_v<Deque&&>;
+        const auto build = [&] {
+            for (const std::span<const T> seg : {d.first_segment(), d.second_segment()}) {
+                T* src = const_cast<T*>(seg.data());
+                T* dst = this->slot(this->_current_size);
+                if constexpr (MOVE) fixed_vector_detail::move_construct_n(src, seg.size(), dst);
+                else fixed_vector_detail::copy_construct_n(seg.data(), seg.size(), dst);
+                this->_current_size = static_cast<size_type>(this->_current_size + seg.size());
+            }
+        };
+#if FIXED_VECTOR_EXCEPTIONS
+        try {
+            build();
+        } catch (...) {
+            this->clear();
+            throw;
+        }
+#else
+        build();
+#endif
+    }
+
+public:
+    /// @brief Default constructor. Initial size will be 0 and no element is constructed
+    fixed_deque()
+        : _head(0),
+          _current_size(0)
+    {}
+
+    /// @brief Copy constructor
+    /// @param d The `fixed_deque` to copy. Size will be the same as `d`
+    fixed_deque(const fixed_deque& d) requires std::is_copy_constructible_v<T>
+        : _head(0),
+          _current_size(0)
+    {
+        this->construct_from(d);
+    }
+
+    /// @brief Move constructor
+    /// @param d The `fixed_deque` to move into this object. Its elements are left in a moved-from state
+    fixed_deque(fixed_deque&& d) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : _head(0),
+          _current_size(0)
+    {
+        this->construct_from(std::move(d));
+    }
+
+    /// @brief Initializer list constructor: allows initialization of `fixed_deque` using curly brace lists
+    /// @param init_list An initializer list in curly braces, e.g. {1, 2, 3, 6, 12, ...}
+    fixed_deque(std::initializer_list<T> init_list)
+        : _head(0),
+          _current_size(0)
+    {
+        fixed_vector_detail::check<Policy>(init_list.size() > CAPACITY, fixed_vector_error::too_many, "Cannot construct",
+                                           init_list.size(), CAPACITY);
+        const size_t count = std::min(init_list.size(), CAPACITY);
+        fixed_vector_detail::copy_construct_n(init_list.begin(), count, this->slot(0));
+        this->_current_size = static_cast<size_type>(count);
+    }
+
+    /// @brief Destructor for trivially destructible types: nothing to do
+    ~fixed_deque() requires std::is_trivially_destructible_v<T> = default;
+
+    /// @brief Destructor: destroys every live element
+    ~fixed_deque() { this->clear(); }
+
+    /// @brief Get the fixed deque capacity
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return CAPACITY; }
+
+    /// @brief Get the fixed deque current logical size
+    [[nodiscard]] size_t size() const { return this->_current_size; }
+
+    /// @brief Clear the fixed deque logical contents, destroying every live element
+    void clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < this->_current_size; ++i) std::destroy_at(this->at_logical(i));
+        }
+        this->_head = 0;
+        this->_current_size = 0;
+    }
+
+    /// @brief Get the contiguous run of elements starting at the front. Empty only if the deque is empty
+    [[nodiscard]] std::span<T> first_segment() {
+        return {this->slot(this->_head), std::min<size_t>(this->_current_size, CAPACITY - this->_head)};
+    }
+
+    /// @brief Get the contiguous run of elements that wrapped around to the start of the buffer. Often empty
+    [[nodiscard]] std::span<T> second_segment() {
+        const size_t first = std::min<size_t>(this->_current_size, CAPACITY - this->_head);
+        return {this->slot(0), this->_current_size - first};
+    }
+
+    /// @brief Get the contiguous run of elements starting at the front. Empty only if the deque is empty
+    [[nodiscard]] std::span<const T> first_segment() const {
+        return {this->slot(this->_head), std::min<size_t>(this->_current_size, CAPACITY - this->_head)};
+    }
+
+    /// @brief Get the contiguous run of elements that wrapped around to the start of the buffer. Often empty
+    [[nodiscard]] std::span<const T> second_segment() const {
+        const size_t first = std::min<size_t>(this->_current_size, CAPACITY - this->_head);
+        return {this->slot(0), this->_current_size - first};
+    }
+
+    /// @brief Construct a value in place at the end of the fixed deque, increasing the logical size by 1
+    /// @param args The arguments to forward to the constructor of `T`
+    /// @return A reference to the new element
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full,
+                                           "Cannot push back", CAPACITY);
+        return this->unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+
+    /// @brief Construct a value in place at the front of the fixed deque, increasing the logical size by 1
+    /// @param args The arguments to forward to the constructor of `T`
+    /// @return A reference to the new element
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full,
+                                           "Cannot push front", CAPACITY);
+        return this->unchecked_emplace_front(std::forward<Args>(args)...);
+    }
+
+    /// @brief Copy a value to the end of the fixed deque, increasing the logical size by 1
+    /// @param val The value to add
+    void push_back(const T& val) { this->emplace_back(val); }
+
+    /// @brief Move a value to the end of the fixed deque, increasing the logical size by 1
+    /// @param val The value to add
+    void push_back(T&& val) { this->emplace_back(std::move(val)); }
+
+    /// @brief Copy a value to the front of the fixed deque, increasing the logical size by 1
+    /// @param val The value to add
+    void push_front(const T& val) { this->emplace_front(val); }
+
+    /// @brief Move a value to the front of the fixed deque, increasing the logical size by 1
+    /// @param val The value to add
+    void push_front(T&& val) { this->emplace_front(std::move(val)); }
+
+    /// @brief Remove a value from the end of the fixed deque, decreasing the logical size by 1
+    /// @return The value previously at the back
+    [[nodiscard]] T pop_back() {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop back");
+        return this->unchecked_pop_back();
+    }
+
+    /// @brief Remove a value from the front of the fixed deque, decreasing the logical size by 1
+    /// @return The value previously at the front
+    [[nodiscard]] T pop_front() {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop front");
+        return this->unchecked_pop_front();
+    }
+
+    /*
+     * Non-throwing API: these never consult the error policy, and report a full or empty deque, or a bad index,
+     * through the return value instead
+     */
+
+    /// @brief Construct a value in place at the end of the fixed deque if there is room
+    /// @return A pointer to the new element, or `nullptr` if the deque was full
+    template <typename... Args>
+    T* try_emplace_back(Args&&... args) {
+        if (this->_current_size == CAPACITY) [[unlikely]] return nullptr;
+        return &this->unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+
+    /// @brief Construct a value in place at the front of the fixed deque if there is room
+    /// @return A pointer to the new element, or `nullptr` if the deque was full
+    template <typename... Args>
+    T* try_emplace_front(Args&&... args) {
+        if (this->_current_size == CAPACITY) [[unlikely]] return nullptr;
+        return &this->unchecked_emplace_front(std::forward<Args>(args)...);
+    }
+
+    /// @brief Copy a value to the end of the fixed deque if there is room
+    /// @return A pointer to the new element, or `nullptr` if the deque was full
+    T* try_push_back(const T& val) { return this->try_emplace_back(val); }
+
+    /// @brief Move a value to the end of the fixed deque if there is room. `val` is untouched if there is not
+    /// @return A pointer to the new element, or `nullptr` if the deque was full
+    T* try_push_back(T&& val) { return this->try_emplace_back(std::move(val)); }
+
+    /// @brief Copy a value to the front of the fixed deque if there is room
+    /// @return A pointer to the new element, or `nullptr` if the deque was full
+    T* try_push_front(const T& val) { return this->try_emplace_front(val); }
+
+    /// @brief Move a value to the front of the fixed deque if there is room. `val` is untouched if there is not
+    /// @return A pointer to the new element, or `nullptr` if the deque was full
+    T* try_push_front(T&& val) { return this->try_emplace_front(std::move(val)); }
+
+    /// @brief Remove the value at the back of the fixed deque if there is one
+    /// @return The value previously at the back, or `std::nullopt` if the deque was empty
+    [[nodiscard]] std::optional<T> try_pop_back() {
+        if (this->_current_size == 0) [[unlikely]] return std::nullopt;
+        return this->unchecked_pop_back();
+    }
+
+    /// @brief Remove the value at the front of the fixed deque if there is one
+    /// @return The value previously at the front, or `std::nullopt` if the deque was empty
+    [[nodiscard]] std::optional<T> try_pop_front() {
+        if (this->_current_size == 0) [[unlikely]] return std::nullopt;
+        return this->unchecked_pop_front();
+    }
+
+    /// @brief Get a pointer to the element at `pos`, or `nullptr` if `pos` is out of range
+    [[nodiscard]] T* try_at(size_t pos) { return pos < this->_current_size ? this->at_logical(pos) : nullptr; }
+
+    /// @brief Get a const pointer to the element at `pos`, or `nullptr` if `pos` is out of range
+    [[nodiscard]] const T* try_at(size_t pos) const {
+        return pos < this->_current_size ? this->at_logical(pos) : nullptr;
+    }
+
+    /*
+     * Unchecked API: for callers that have already established the precondition.
+     * Violating it is undefined behaviour regardless of the error policy
+     */
+
+    /// @brief Construct a value in place at the end of the fixed deque without checking capacity
+    /// @warning DOES NOT BOUNDS CHECK: the deque must not be full
+    template <typename... Args>
+    T& unchecked_emplace_back(Args&&... args) {
+        T* elem = ::new (static_cast<void*>(this->at_logical(this->_current_size))) T(std::forward<Args>(args)...);
+        ++this->_current_size;
+        return *elem;
+    }
+
+    /// @brief Construct a value in place at the front of the fixed deque without checking capacity
+    /// @warning DOES NOT BOUNDS CHECK: the deque must not be full
+    template <typename... Args>
+    T& unchecked_emplace_front(Args&&... args) {
+        const size_type head = static_cast<size_type>(wrap(this->_head + CAPACITY - 1));
+        T* elem = ::new (static_cast<void*>(this->slot(head))) T(std::forward<Args>(args)...);
+        this->_head = head;
+        ++this->_current_size;
+        return *elem;
+    }
+
+    /// @brief Copy a value to the end of the fixed deque without checking capacity
+    /// @warning DOES NOT BOUNDS CHECK: the deque must not be full
+    T& unchecked_push_back(const T& val) { return this->unchecked_emplace_back(val); }
+
+    /// @brief Move a value to the end of the fixed deque without checking capacity
+    /// @warning DOES NOT BOUNDS CHECK: the deque must not be full
+    T& unchecked_push_back(T&& val) { return this->unchecked_emplace_back(std::move(val)); }
+
+    /// @brief Remove the value at the back of the fixed deque without checking for emptiness
+    /// @warning DOES NOT BOUNDS CHECK: the deque must not be empty
+    [[nodiscard]] T unchecked_pop_back() {
+        T* back = this->at_logical(this->_current_size - 1);
+        T val = std::move(*back);
+        std::destroy_at(back);
+        --this->_current_size;
+        return val;
+    }
+
+    /// @brief Remove the value at the front of the fixed deque without checking for emptiness
+    /// @warning DOES NOT BOUNDS CHECK: the deque must not be empty
+    [[nodiscard]] T unchecked_pop_front() {
+        T* front = this->slot(this->_head);
+        T val = std::move(*front);
+        std::destroy_at(front);
+        this->_head = static_cast<size_type>(wrap(this->_head + 1));
+        --this->_current_size;
+        return val;
+    }
+
+    /// @brief Reverse the fixed deque contents in-place
+    void reverse() { std::reverse(this->begin(), this->end()); }
+
+    /// @brief Allow square-bracket indexing like a `std::deque`
+    T& operator[](size_t pos) {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range, "Cannot access",
+                                           pos, this->_current_size);
+        return *this->at_logical(pos);
+    }
+
+    /// @brief Allow const square-bracket indexing like a `std::deque`
+    const T& operator[](size_t pos) const {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range, "Cannot access",
+                                           pos, this->_current_size);
+        return *this->at_logical(pos);
+    }
+
+    /// @brief Allow another `fixed_deque` to be copied into this one using the `=` operator
+    fixed_deque& operator= (const fixed_deque& d) requires std::is_copy_constructible_v<T> {
+        if (this == &d) return *this;
+        this->clear();
+        this->construct_from(d);
+        return *this;
+    }
+
+    /// @brief Allow another `fixed_deque` to be moved into this one using the `=` operator
+    fixed_deque& operator= (fixed_deque&& d) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this == &d) return *this;
+        this->clear();
+        this->construct_from(std::move(d));
+        return *this;
+    }
+
+    /**
+     * @brief Swap the contents of two `fixed_deque`s
+     *
+     * Only the live elements are touched: the common prefix is swapped element-wise and the longer deque's remaining
+     * elements are moved across and destroyed at their source. Each deque keeps its own head
+     */
+    void swap(fixed_deque& d) noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+        if (this == &d) return;
+        fixed_deque& shorter = this->_current_size <= d._current_size ? *this : d;
+        fixed_deque& longer = this->_current_size <= d._current_size ? d : *this;
+        const size_t common = shorter._current_size;
+        using std::swap;
+        for (size_t i = 0; i < common; ++i) swap(*shorter.at_logical(i), *longer.at_logical(i));
+        // Move the whole remainder before destroying any of it, so a throwing move leaves both deques valid
+        for (size_t i = common; i < longer._current_size; ++i) {
+            std::construct_at(shorter.at_logical(i), std::move(*longer.at_logical(i)));
+            ++shorter._current_size;
+        }
+        for (size_t i = common; i < longer._current_size; ++i) std::destroy_at(longer.at_logical(i));
+        longer._current_size = static_cast<size_type>(common);
+    }
+
+    /// @brief Swap the contents of two `fixed_deque`s
+    friend void swap(fixed_deque& a, fixed_deque& b) noexcept(noexcept(a.swap(b))) { a.swap(b); }
+
+    /// @brief Allow two `fixed_deque`s to be compared using `==`
+    bool operator== (const fixed_deque& d) const noexcept {
+        return this->_current_size == d._current_size && std::equal(this->begin(), this->end(), d.begin());
+    }
+
+    /**
+     * @class basic_iterator
+     * @brief Random-access iterator over the logical sequence of a `fixed_deque`
+     * @tparam CONST Whether the iterator gives const access
+     */
+    template <bool CONST>
+    class basic_iterator {
+        using deque_type = std::conditional_t<CONST, const fixed_deque, fixed_deque>;
+
+        deque_type* _deque;
+        size_t _pos;
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<CONST, const T*, T*>;
+        using reference = std::conditional_t<CONST, const T&, T&>;
+        using iterator_category = std::random_access_iterator_tag;
+
+        basic_iterator() : _deque(nullptr), _pos(0) {}
+        basic_iterator(deque_type* deque, size_t pos) : _deque(deque), _pos(pos) {}
+
+        /// @brief Allow a mutable iterator to be converted to a const one
+        operator basic_iterator<true>() const requires (!CONST) { return {this->_deque, this->_pos}; }
+
+        reference operator*() const { return *this->_deque->at_logical(this->_pos); }
+        pointer operator->() const { return this->_deque->at_logical(this->_pos); }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        basic_iterator& operator++() { ++this->_pos; return *this; }
+        basic_iterator operator++(int) { basic_iterator tmp = *this; ++this->_pos; return tmp; }
+        basic_iterator& operator--() { --this->_pos; return *this; }
+        basic_iterator operator--(int) { basic_iterator tmp = *this; --this->_pos; return tmp; }
+        /// @brief `_pos` is unsigned, so a negative `n` is applied as an explicit step back
+        basic_iterator& operator+=(difference_type n) {
+            if (n >= 0) this->_pos += static_cast<size_t>(n);
+            else this->_pos -= static_cast<size_t>(-n);
+            return *this;
+        }
+        basic_iterator& operator-=(difference_type n) {
+            if (n >= 0) this->_pos -= static_cast<size_t>(n);
+            else this->_pos += static_cast<size_t>(-n);
+            return *this;
+        }
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+        friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+        friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs) {
+            return static_cast<difference_type>(lhs._pos) - static_cast<difference_type>(rhs._pos);
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs._pos == rhs._pos; }
+        friend auto operator<=>(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs._pos <=> rhs._pos; }
+    };
+
+    /// @brief Mutable iterator type
+    using iterator = basic_iterator<false>;
+    /// @brief Const iterator type
+    using const_iterator = basic_iterator<true>;
+
+    /// @brief Get mutable iterator to beginning
+    iterator begin() { return iterator(this, 0); }
+
+    /// @brief Get mutable iterator to end
+    iterator end() { return iterator(this, this->_current_size); }
+
+    /// @brief Get const iterator to beginning
+    const_iterator cbegin() const { return const_iterator(this, 0); }
+
+    /// @brief Get const iterator to end
+    const_iterator cend() const { return const_iterator(this, this->_current_size); }
+
+    /// @brief Overload for getting const iterator to beginning
+    const_iterator begin() const { return cbegin(); }
+
+    /// @brief Overload for getting const iterator to end
+    const_iterator end() const { return cend(); }
+
+    /// @brief Mutable reverse iterator type
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    /// @brief Const reverse iterator type
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /// @brief Get mutable reverse iterator to the last element
+    reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+
+    /// @brief Get mutable reverse iterator to before the first element
+    reverse_iterator rend() { return reverse_iterator(this->begin()); }
+
+    /// @brief Get const reverse iterator to the last element
+    const_reverse_iterator crbegin() const { return const_reverse_iterator(this->cend()); }
+
+    /// @brief Get const reverse iterator to before the first element
+    const_reverse_iterator crend() const { return const_reverse_iterator(this->cbegin()); }
+
+    /// @brief Overload for getting const reverse iterator to the last element
+    const_reverse_iterator rbegin() const { return crbegin(); }
+
+    /// @brief Overload for getting const reverse iterator to before the first element
+    const_reverse_iterator rend() const { return crend(); }
+};
+
+#endif //FIXED_DEQUE_HPP
@@ -0,0 +1,490 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef FIXED_FLAT_MAP_HPP
+#define FIXED_FLAT_MAP_HPP
+
+#include "fixed_flat_set.hpp"
+
+#include <span>
+#include <utility>
+
+/**
+ * @class fixed_flat_map
+ * @brief A sorted map of at most `CAPACITY` unique keys with no dynamic memory allocation
+ *
+ * Keys and values live in two separate contiguous arrays, so a lookup only touches key memory and `values()` can be
+ * scanned on its own. Searching, inserting and bulk merging work like `fixed_flat_set`, moving the value of each
+ * key along with it. Iterating yields `std::pair`s of references
+ * @tparam K The key type
+ * @tparam V The mapped type
+ * @tparam CAPACITY The compile-time capacity of the map
+ * @tparam Compare The strict weak ordering of the keys. A transparent one, e.g. `std::less<>`, enables lookup by other
+ * key types
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types
+ */
+template <typename K, typename V, size_t CAPACITY, typename Compare = std::less<K>,
+          typename Policy = fixed_vector_policy::default_policy>
+class fixed_flat_map {
+    static_assert(CAPACITY > 0, "Capacity cannot be 0");
+
+public:
+    /// @brief The type used to store the logical size: the smallest unsigned type that can hold `CAPACITY`
+    using size_type = fixed_vector_detail::smallest_size_t<CAPACITY>;
+    using key_type = K;
+    using mapped_type = V;
+    using key_compare = Compare;
+    /// @brief An entry by value
+    using value_type = std::pair<K, V>;
+    /// @brief A proxy reference to an entry: the key is never mutable
+    using reference = std::pair<const K&, V&>;
+    /// @brief A proxy const reference to an entry
+    using const_reference = std::pair<const K&, const V&>;
+
+private:
+    /// @brief The current logical size of the map
+    size_type _current_size;
+    /// @brief The ordering of the keys
+    [[no_unique_address]] Compare _comp;
+    /// @brief Uninitialized storage for the sorted keys. Only the first `_current_size` slots hold objects
+    fixed_vector_detail::storage<K, CAPACITY> _keys;
+    /// @brief Uninitialized storage for the values, in the same order as the keys
+    fixed_vector_detail::storage<V, CAPACITY> _values;
+
+    /// @brief Whether moving entries cannot throw, so the key and value columns can be shifted one after the other
+    static constexpr bool NOTHROW_SHIFT = std::is_nothrow_move_constructible_v<K> &&
+                                          std::is_nothrow_move_assignable_v<K> &&
+                                          std::is_nothrow_move_constructible_v<V> &&
+                                          std::is_nothrow_move_assignable_v<V>;
+
+    /// @brief Whether copying entries out of `It` and moving entries around cannot throw, so `insert_sorted` can merge
+    /// in place
+    template <typename It, typename KRef = decltype(std::get<0>(*std::declval<It>())),
+              typename VRef = decltype(std::get<1>(*std::declval<It>()))>
+    static constexpr bool NOTHROW_MERGE = NOTHROW_SHIFT &&
+                                          std::is_nothrow_constructible_v<K, KRef> &&
+                                          std::is_nothrow_assignable_v<K&, KRef> &&
+                                          std::is_nothrow_constructible_v<V, VRef> &&
+                                          std::is_nothrow_assignable_v<V&, VRef>;
+
+    constexpr K* key_slot(size_t pos) noexcept { return this->_keys.data() + pos; }
+    constexpr const K* key_slot(size_t pos) const noexcept { return this->_keys.data() + pos; }
+    constexpr V* value_slot(size_t pos) noexcept { return this->_values.data() + pos; }
+    constexpr const V* value_slot(size_t pos) const noexcept { return this->_values.data() + pos; }
+
+    /// @brief Destroy the entries in `[first, _current_size)` and shrink the logical size to `first`
+    constexpr void destroy_from(size_t first) noexcept {
+        std::destroy(this->key_slot(first), this->key_slot(this->_current_size));
+        std::destroy(this->value_slot(first), this->value_slot(this->_current_size));
+        this->_current_size = static_cast<size_type>(first);
+    }
+
+    /// @brief Copy or move every entry of `m` into this empty map. If a value throws, the keys built are destroyed
+    template <bool MOVE, typename Other>
+    constexpr void construct_from(Other& m) {
+        const auto build = [&](auto* src, auto* dst) {
+            if constexpr (MOVE) fixed_vector_detail::move_construct_n(src, m._current_size, dst);
+            else fixed_vector_detail::copy_construct_n(src, m._current_size, dst);
+        };
+        build(m.key_slot(0), this->key_slot(0));
+#if FIXED_VECTOR_EXCEPTIONS
+        try {
+            build(m.value_slot(0), this->value_slot(0));
+        } catch (...) {
+            std::destroy(this->key_slot(0), this->key_slot(m._current_size));
+            throw;
+        }
+#else
+        build(m.value_slot(0), this->value_slot(0));
+#endif
+        this->_current_size = m._current_size;
+        this->_comp = m._comp;
+    }
+
+    /// @brief Get the index of the first key not ordered before `key`
+    template <typename Key>
+    constexpr size_t lower_index(const Key& key) const {
+        return fixed_vector_detail::partition_point<CAPACITY>(this->key_slot(0), this->_current_size,
+                                                              [&](const K& k) { return this->_comp(k, key); });
+    }
+
+    /// @brief Get the index of `key`, or `_current_size` if it is not in the map
+    template <typename Key>
+    constexpr size_t find_index(const Key& key) const {
+        const size_t pos = this->lower_index(key);
+        return (pos != this->_current_size && !this->_comp(key, *this->key_slot(pos))) ? pos : this->_current_size;
+    }
+
+    /**
+     * @brief Insert an entry at `pos`, shifting every later entry to the right
+     *
+     * Shifting the keys and then the values leaves raw slots in both columns until the new entry is built, so it is
+     * only done when moves cannot throw. Otherwise both columns first grow by one slot at the end, and the entries
+     * are then move-assigned down over live objects only. If a move throws, an existing entry may have been moved
+     * from and the order lost, so the map is cleared, as `std::flat_map` does. Appending leaves the map unchanged
+     * @warning DOES NOT BOUNDS CHECK
+     */
+    constexpr void unchecked_insert_at(size_t pos, K&& key, V&& val) {
+        if constexpr (NOTHROW_SHIFT) {
+            fixed_vector_detail::shift_right(this->key_slot(0), this->_current_size, pos, 1);
+            fixed_vector_detail::shift_right(this->value_slot(0), this->_current_size, pos, 1);
+            std::construct_at(this->key_slot(pos), std::move(key));
+            std::construct_at(this->value_slot(pos), std::move(val));
+            ++this->_current_size;
+        } else {
+            const size_t size = this->_current_size;
+            // Grow both columns by the last entry, or by the new entry when appending
+            K& last_key = pos == size ? key : *this->key_slot(size - 1);
+            V& last_val = pos == size ? val : *this->value_slot(size - 1);
+            bool key_grown = false;
+            const auto insert = [&] {
+                std::construct_at(this->key_slot(size), std::move(last_key));
+                key_grown = true;
+                std::construct_at(this->value_slot(size), std::move(last_val));
+                ++this->_current_size;
+                if (pos == size) return;
+                for (size_t i = size - 1; i > pos; --i) {
+                    *this->key_slot(i) = std::move(*this->key_slot(i - 1));
+                    *this->value_slot(i) = std::move(*this->value_slot(i - 1));
+                }
+                *this->key_slot(pos) = std::move(key);
+                *this->value_slot(pos) = std::move(val);
+            };
+#if FIXED_VECTOR_EXCEPTIONS
+            try {
+                insert();
+            } catch (...) {
+                if (key_grown && this->_current_size == size) std::destroy_at(this->key_slot(size));
+                // Appending touches no existing entry, anything else may have moved one out of order
+                if (pos != size) this->destroy_from(0);
+                throw;
+            }
+#else
+            insert();
+#endif
+        }
+    }
+
+    /// @brief Get the value of `key`, inserting it with a value built from `args` first if it is missing
+    template <typename KeyArg, typename... Args>
+    constexpr std::pair<V*, bool> try_emplace_impl(KeyArg&& key, Args&&... args) {
+        const size_t pos = this->lower_index(key);
+        if (pos != this->_current_size && !this->_comp(key, *this->key_slot(pos)))
+            return {this->value_slot(pos), false};
+        fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full,
+                                           "Cannot insert", CAPACITY);
+        // Build the entry first: the arguments may refer to entries that are about to move
+        K k(std::forward<KeyArg>(key));
+        V v(std::forward<Args>(args)...);
+        this->unchecked_insert_at(pos, std::move(k), std::move(v));
+        return {this->value_slot(pos), true};
+    }
+
+    /// @brief Get a pointer to the value at index `pos`, or `nullptr` if `pos` is `_current_size`
+    constexpr V* value_of(size_t pos) noexcept {
+        return pos == this->_current_size ? nullptr : this->value_slot(pos);
+    }
+
+    /// @brief Get a const pointer to the value at index `pos`, or `nullptr` if `pos` is `_current_size`
+    constexpr const V* value_of(size_t pos) const noexcept {
+        return pos == this->_current_size ? nullptr : this->value_slot(pos);
+    }
+
+    /// @brief Remove the entry with a key equivalent to `key`, if any
+    template <typename Key>
+    constexpr size_t erase_key(const Key& key) {
+        const size_t pos = this->find_index(key);
+        if (pos == this->_current_size) return 0;
+        this->unchecked_erase_at(pos);
+        return 1;
+    }
+
+    /// @brief Remove the entry at `pos`, shifting every later entry to the left
+    /// @warning DOES NOT BOUNDS CHECK
+    constexpr void unchecked_erase_at(size_t pos) {
+        fixed_vector_detail::shift_left(this->key_slot(0), this->_current_size, pos, 1);
+        fixed_vector_detail::shift_left(this->value_slot(0), this->_current_size, pos, 1);
+        --this->_current_size;
+    }
+
+public:
+    /// @brief Default constructor. Initial size will be 0
+    constexpr fixed_flat_map() : _current_size(0), _comp() {}
+
+    /// @brief Construct an empty map ordered by `comp`
+    constexpr explicit fixed_flat_map(const Compare& comp) : _current_size(0), _comp(comp) {}
+
+    /// @brief Initializer list constructor: entries may come in any order, the first of equivalent keys is kept
+    constexpr fixed_flat_map(std::initializer_list<value_type> init_list) : fixed_flat_map() {
+        for (const value_type& entry : init_list) this->try_emplace(entry.first, entry.second);
+    }
+
+    /// @brief Copy constructor
+    constexpr fixed_flat_map(const fixed_flat_map& m)
+        requires (std::is_copy_constructible_v<K> && std::is_copy_constructible_v<V>)
+        : _current_size(0), _comp(m._comp)
+    {
+        this->construct_from<false>(m);
+    }
+
+    /// @brief Move constructor. The entries of `m` are left in a moved-from state
+    constexpr fixed_flat_map(fixed_flat_map&& m)
+        noexcept(std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>)
+        : _current_size(0), _comp(m._comp)
+    {
+        this->construct_from<true>(m);
+    }
+
+    /// @brief Destructor for trivially destructible entries: nothing to do
+    constexpr ~fixed_flat_map()
+        requires (std::is_trivially_destructible_v<K> && std::is_trivially_destructible_v<V>) = default;
+
+    /// @brief Destructor: destroys every live entry
+    constexpr ~fixed_flat_map() { this->destroy_from(0); }
+
+    /// @brief Allow another map to be copied into this one using the `=` operator
+    constexpr fixed_flat_map& operator= (const fixed_flat_map& m)
+        requires (std::is_copy_constructible_v<K> && std::is_copy_constructible_v<V>)
+    {
+        if (this == &m) return *this;
+        this->destroy_from(0);
+        this->construct_from<false>(m);
+        return *this;
+    }
+
+    /// @brief Allow another map to be moved into this one using the `=` operator
+    constexpr fixed_flat_map& operator= (fixed_flat_map&& m)
+        noexcept(std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>)
+    {
+        if (this == &m) return *this;
+        this->destroy_from(0);
+        this->construct_from<true>(m);
+        return *this;
+    }
+
+    /// @brief Get the compile-time capacity of the map
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return CAPACITY; }
+
+    /// @brief Get the number of entries
+    [[nodiscard]] constexpr size_t size() const noexcept { return this->_current_size; }
+
+    /// @brief Whether the map holds no entries
+    [[nodiscard]] constexpr bool empty() const noexcept { return this->_current_size == 0; }
+
+    /// @brief Clear the map, destroying every entry
+    constexpr void clear() { this->destroy_from(0); }
+
+    /// @brief Get the ordering of the keys
+    [[nodiscard]] constexpr key_compare key_comp() const { return this->_comp; }
+
+    /// @brief Get the sorted keys
+    [[nodiscard]] constexpr std::span<const K> keys() const noexcept {
+        return std::span<const K>(this->key_slot(0), this->_current_size);
+    }
+
+    /// @brief Get the values, in the order of their keys
+    [[nodiscard]] constexpr std::span<V> values() noexcept {
+        return std::span<V>(this->value_slot(0), this->_current_size);
+    }
+
+    /// @brief Get the values, in the order of their keys
+    [[nodiscard]] constexpr std::span<const V> values() const noexcept {
+        return std::span<const V>(this->value_slot(0), this->_current_size);
+    }
+
+    /// @brief Insert `key` with a value constructed from `args`, unless an equivalent key is already present
+    /// @return A pointer to the value of the key equivalent to `key`, and whether it was inserted
+    template <typename... Args>
+    constexpr std::pair<V*, bool> try_emplace(const K& key, Args&&... args) {
+        return this->try_emplace_impl(key, std::forward<Args>(args)...);
+    }
+
+    /// @brief Insert `key` with a value constructed from `args`, unless an equivalent key is already present
+    /// @return A pointer to the value of the key equivalent to `key`, and whether it was inserted
+    template <typename... Args>
+    constexpr std::pair<V*, bool> try_emplace(K&& key, Args&&... args) {
+        return this->try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+    }
+
+    /// @brief Insert `key` with `val`, or assign `val` to the value of an equivalent key already present
+    /// @return A pointer to the value of the key equivalent to `key`, and whether it was inserted
+    template <typename M>
+    constexpr std::pair<V*, bool> insert_or_assign(const K& key, M&& val) {
+        const size_t pos = this->find_index(key);
+        if (pos == this->_current_size) return this->try_emplace_impl(key, std::forward<M>(val));
+        *this->value_slot(pos) = std::forward<M>(val);
+        return {this->value_slot(pos), false};
+    }
+
+    /// @brief Get the value of `key`, inserting a value-initialized one first if it is missing
+    constexpr V& operator[](const K& key) requires std::is_default_constructible_v<V> {
+        return *this->try_emplace_impl(key).first;
+    }
+
+    /**
+     * @brief Insert every entry of `[first, last)` whose key is not already present, with one shift of the existing
+     * entries
+     *
+     * The new keys are counted and checked against the capacity before anything is modified, then merged in a
+     * single pass. Of several equivalent keys in the range only the first is inserted. The merge leaves uninitialized
+     * slots among the entries while it runs, so if a copy or move of `K` or `V` may throw, the entries are inserted one
+     * at a time instead, and a throw leaves the map valid with a prefix of the new entries
+     * @param first,last A range of pairs sorted by key according to `key_comp()`
+     */
+    template <std::forward_iterator It>
+    constexpr void insert_sorted(It first, It last) {
+        const auto key_of = [](const auto& entry) -> decltype(auto) { return std::get<0>(entry); };
+        const size_t added = fixed_vector_detail::count_new_keys(this->key_slot(0), this->_current_size, first, last,
+                                                                 this->_comp, key_of);
+        if (added == 0) return;
+        fixed_vector_detail::check<Policy>(added > CAPACITY - this->_current_size, fixed_vector_error::too_many,
+                                           "Cannot insert", this->_current_size + added, CAPACITY);
+        if constexpr (!NOTHROW_MERGE<It>) {
+            for (; first != last; ++first) this->try_emplace_impl(std::get<0>(*first), std::get<1>(*first));
+            return;
+        }
+        fixed_vector_detail::shift_right(this->key_slot(0), this->_current_size, 0, added);
+        fixed_vector_detail::shift_right(this->value_slot(0), this->_current_size, 0, added);
+        fixed_vector_detail::merge_sorted(
+            this->key_slot(0), this->_current_size, added, first, last, this->_comp, key_of,
+            [&](size_t d, bool raw, It it) {
+                if (raw) {
+                    std::construct_at(this->key_slot(d), std::get<0>(*it));
+                    std::construct_at(this->value_slot(d), std::get<1>(*it));
+                } else {
+                    *this->key_slot(d) = std::get<0>(*it);
+                    *this->value_slot(d) = std::get<1>(*it);
+                }
+            },
+            [&](size_t d, bool raw, size_t from) {
+                if (raw) {
+                    std::construct_at(this->key_slot(d), std::move(*this->key_slot(from)));
+                    std::construct_at(this->value_slot(d), std::move(*this->value_slot(from)));
+                } else {
+                    *this->key_slot(d) = std::move(*this->key_slot(from));
+                    *this->value_slot(d) = std::move(*this->value_slot(from));
+                }
+            });
+        this->_current_size = static_cast<size_type>(this->_current_size + added);
+    }
+
+    /*
+     * Lookups take `const K&`, so that e.g. a string literal is converted to `K` once rather than on every comparison
+     * of the search. With a transparent `Compare`, such as `std::less<>`, they also accept any key type as is
+     */
+
+    /// @brief Remove the entry with a key equivalent to `key`, if any
+    /// @return The number of entries removed, 0 or 1
+    constexpr size_t erase(const K& key) { return this->erase_key(key); }
+
+    /// @brief Remove the entry with a key equivalent to `key`, if any. Needs a transparent `Compare`
+    /// @return The number of entries removed, 0 or 1
+    template <typename Key>
+    constexpr size_t erase(const Key& key) requires fixed_vector_detail::is_transparent<Compare> {
+        return this->erase_key(key);
+    }
+
+    /// @brief Get a pointer to the value of `key`, or `nullptr` if it is missing
+    [[nodiscard]] constexpr V* find(const K& key) { return this->value_of(this->find_index(key)); }
+
+    /// @brief Get a pointer to the value of `key`, or `nullptr` if it is missing. Needs a transparent `Compare`
+    template <typename Key>
+    [[nodiscard]] constexpr V* find(const Key& key) requires fixed_vector_detail::is_transparent<Compare> {
+        return this->value_of(this->find_index(key));
+    }
+
+    /// @brief Get a const pointer to the value of `key`, or `nullptr` if it is missing
+    [[nodiscard]] constexpr const V* find(const K& key) const { return this->value_of(this->find_index(key)); }
+
+    /// @brief Get a const pointer to the value of `key`, or `nullptr` if it is missing. Needs a transparent `Compare`
+    template <typename Key>
+    [[nodiscard]] constexpr const V* find(const Key& key) const requires fixed_vector_detail::is_transparent<Compare> {
+        return this->value_of(this->find_index(key));
+    }
+
+    /// @brief Whether a key equivalent to `key` is in the map
+    [[nodiscard]] constexpr bool contains(const K& key) const { return this->find_index(key) != this->_current_size; }
+
+    /// @brief Whether a key equivalent to `key` is in the map. Needs a transparent `Compare`
+    template <typename Key>
+    [[nodiscard]] constexpr bool contains(const Key& key) const requires fixed_vector_detail::is_transparent<Compare> {
+        return this->find_index(key) != this->_current_size;
+    }
+
+    /// @brief Get the number of keys equivalent to `key`, 0 or 1
+    [[nodiscard]] constexpr size_t count(const K& key) const { return this->contains(key) ? 1 : 0; }
+
+    /// @brief Get the number of keys equivalent to `key`, 0 or 1. Needs a transparent `Compare`
+    template <typename Key>
+    [[nodiscard]] constexpr size_t count(const Key& key) const requires fixed_vector_detail::is_transparent<Compare> {
+        return this->contains(key) ? 1 : 0;
+    }
+
+    /// @brief Allow two `fixed_flat_map`s to be compared using `==`
+    constexpr bool operator== (const fixed_flat_map& m) const {
+        return this->_current_size == m._current_size &&
+               std::equal(this->key_slot(0), this->key_slot(this->_current_size), m.key_slot(0)) &&
+               std::equal(this->value_slot(0), this->value_slot(this->_current_size), m.value_slot(0));
+    }
+
+    /**
+     * @class basic_iterator
+     * @brief Iterates over entries in key order, dereferencing to a pair of references
+     *
+     * Dereferencing yields a proxy rather than a real reference, so this only models an input iterator for the
+     * classic algorithms; use `keys()` and `values()` for algorithms over one array
+     * @tparam CONST Whether the iterator gives const access to the values
+     */
+    template <bool CONST>
+    class basic_iterator {
+        using map_type = std::conditional_t<CONST, const fixed_flat_map, fixed_flat_map>;
+
+        map_type* _map;
+        size_t _pos;
+    public:
+        using value_type = fixed_flat_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<CONST, const_reference, fixed_flat_map::reference>;
+        using iterator_category = std::input_iterator_tag;
+
+        constexpr basic_iterator() : _map(nullptr), _pos(0) {}
+        constexpr basic_iterator(map_type* map, size_t pos) : _map(map), _pos(pos) {}
+
+        constexpr reference operator*() const {
+            return reference(*this->_map->key_slot(this->_pos), *this->_map->value_slot(this->_pos));
+        }
+
+        constexpr basic_iterator& operator++() { ++this->_pos; return *this; }
+        constexpr basic_iterator operator++(int) { basic_iterator tmp = *this; ++this->_pos; return tmp; }
+
+        friend constexpr bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) {
+            return lhs._pos == rhs._pos;
+        }
+    };
+
+    /// @brief Mutable entry iterator type
+    using iterator = basic_iterator<false>;
+    /// @brief Const entry iterator type
+    using const_iterator = basic_iterator<true>;
+
+    /// @brief Get mutable iterator to the first entry
+    constexpr iterator begin() { return iterator(this, 0); }
+
+    /// @brief Get mutable iterator past the last entry
+    constexpr iterator end() { return iterator(this, this->_current_size); }
+
+    /// @brief Get const iterator to the first entry
+    constexpr const_iterator cbegin() const { return const_iterator(this, 0); }
+
+    /// @brief Get const iterator past the last entry
+    constexpr const_iterator cend() const { return const_iterator(this, this->_current_size); }
+
+    /// @brief Overload for getting const iterator to the first entry
+    constexpr const_iterator begin() const { return cbegin(); }
+
+    /// @brief Overload for getting const iterator past the last entry
+    constexpr const_iterator end() const { return cend(); }
+};
+
+#endif //FIXED_FLAT_MAP_HPP
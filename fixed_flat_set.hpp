@@ -0,0 +1,427 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef FIXED_FLAT_SET_HPP
+#define FIXED_FLAT_SET_HPP
+
+#include "fixed_vector.hpp"
+
+#include <functional>
+#include <iterator>
+
+namespace fixed_vector_detail {
+    /// @brief Up to this capacity, sorted arithmetic keys are searched with a vectorizable linear count
+    inline constexpr size_t LINEAR_SEARCH_MAX = 32;
+
+    /// @brief Whether `Compare` orders keys of other types without converting them, which enables heterogeneous lookup
+    template <typename Compare>
+    inline constexpr bool is_transparent = requires { typename Compare::is_transparent; };
+
+    /**
+     * @brief Get the number of leading elements of `data` for which `pred` holds, `pred` being true for a prefix
+     *
+     * For small `CAPACITY` and arithmetic keys the predicate is summed over every element, which compilers turn into
+     * SIMD compares. Otherwise a binary search whose only branch is the loop condition: the halving step is a
+     * conditional move, so mispredictions do not depend on the keys
+     */
+    template <size_t CAPACITY, typename K, typename Pred>
+    constexpr size_t partition_point(const K* data, size_t size, Pred pred) {
+        if constexpr (CAPACITY <= LINEAR_SEARCH_MAX && std::is_arithmetic_v<K>) {
+            size_t n = 0;
+            for (size_t i = 0; i < size; ++i) n += static_cast<size_t>(pred(data[i]));
+            return n;
+        } else {
+            if (size == 0) return 0;
+            const K* base = data;
+            while (size > 1) {
+                const size_t half = size / 2;
+                base = pred(base[half]) ? base + half : base;
+                size -= half;
+            }
+            return static_cast<size_t>(base - data) + static_cast<size_t>(pred(*base));
+        }
+    }
+
+    /**
+     * @brief Count the keys of the sorted range `[first, last)` that are in neither `keys` nor earlier in the range
+     *
+     * Walks both sorted sequences once. `merge_sorted` must skip exactly the same input elements
+     */
+    template <typename K, typename Compare, typename It, typename Proj>
+    constexpr size_t count_new_keys(const K* keys, size_t size, It first, It last, const Compare& comp, Proj proj) {
+        size_t added = 0, s = 0;
+        for (It prev = last, it = first; it != last; prev = it, ++it) {
+            while (s < size && comp(keys[s], proj(*it))) ++s;
+            if (s < size && !comp(proj(*it), keys[s])) continue;
+            if (prev != last && !comp(proj(*prev), proj(*it))) continue;
+            ++added;
+        }
+        return added;
+    }
+
+    /**
+     * @brief Merge the sorted range `[first, last)` into the sorted live elements `keys[0, size)`, skipping keys
+     * already present
+     *
+     * `added` must be the result of `count_new_keys`, and there must be room for that many more elements. The
+     * existing elements are first shifted up by `added` in one pass, then merged forward: the write position never
+     * passes the read position, so each slot is either constructed (still raw) or assigned (already moved from).
+     * `place(slot, raw, it)` writes input element `it` and `relocate(slot, raw, from)` moves existing element `from`
+     */
+    template <typename K, typename Compare, typename It, typename Proj, typename Place, typename Relocate>
+    constexpr void merge_sorted(const K* keys, size_t size, size_t added, It first, It last, const Compare& comp,
+                                Proj proj, Place place, Relocate relocate) {
+        const size_t end = size + added;
+        size_t s = added, d = 0;
+        for (It prev = last, it = first; d < s && it != last; prev = it, ++it) {
+            while (s < end && comp(keys[s], proj(*it))) {
+                relocate(d, d < added, s);
+                ++d;
+                ++s;
+            }
+            if (s < end && !comp(proj(*it), keys[s])) continue;
+            if (prev != last && !comp(proj(*prev), proj(*it))) continue;
+            place(d, d < added, it);
+            ++d;
+        }
+    }
+}
+
+/**
+ * @class fixed_flat_set
+ * @brief A sorted set of at most `CAPACITY` unique keys in contiguous storage, no dynamic memory allocation
+ *
+ * Lookups use `fixed_vector_detail::partition_point`: a branchless binary search, or a SIMD-friendly linear count
+ * when `CAPACITY` is small and the keys are arithmetic. Inserting and erasing shift the tail like
+ * `fixed_vector::emplace`, and `insert_sorted` merges a whole sorted range with a single shift
+ * @tparam K The key type
+ * @tparam CAPACITY The compile-time capacity of the set
+ * @tparam Compare The strict weak ordering of the keys. A transparent one, e.g. `std::less<>`, enables lookup by other
+ * key types
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types
+ */
+template <typename K, size_t CAPACITY, typename Compare = std::less<K>,
+          typename Policy = fixed_vector_policy::default_policy>
+class fixed_flat_set {
+    static_assert(CAPACITY > 0, "Capacity cannot be 0");
+
+public:
+    /// @brief The type used to store the logical size: the smallest unsigned type that can hold `CAPACITY`
+    using size_type = fixed_vector_detail::smallest_size_t<CAPACITY>;
+    using key_type = K;
+    using value_type = K;
+    using key_compare = Compare;
+    using reference = const K&;
+    using const_reference = const K&;
+    using difference_type = std::ptrdiff_t;
+    /// @brief Iterators are const pointers: modifying a key in place could break the ordering
+    using iterator = const K*;
+    using const_iterator = const K*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    /// @brief The current logical size of the set
+    size_type _current_size;
+    /// @brief The ordering of the keys
+    [[no_unique_address]] Compare _comp;
+    /// @brief Uninitialized storage for the sorted keys. Only the first `_current_size` slots hold objects
+    fixed_vector_detail::storage<K, CAPACITY> _buf;
+
+    /// @brief Whether copying keys out of `It` and moving keys cannot throw, so `insert_sorted` can merge in place
+    template <typename It>
+    static constexpr bool NOTHROW_MERGE = std::is_nothrow_move_constructible_v<K> &&
+                                          std::is_nothrow_move_assignable_v<K> &&
+                                          std::is_nothrow_constructible_v<K, std::iter_reference_t<It>> &&
+                                          std::is_nothrow_assignable_v<K&, std::iter_reference_t<It>>;
+
+    constexpr K* slot(size_t pos) noexcept { return this->_buf.data() + pos; }
+    constexpr const K* slot(size_t pos) const noexcept { return this->_buf.data() + pos; }
+
+    /// @brief Destroy the keys in `[first, _current_size)` and shrink the logical size to `first`
+    constexpr void destroy_from(size_t first) noexcept {
+        std::destroy(this->slot(first), this->slot(this->_current_size));
+        this->_current_size = static_cast<size_type>(first);
+    }
+
+    /// @brief Get the index of the first key not ordered before `key`
+    template <typename Key>
+    constexpr size_t lower_index(const Key& key) const {
+        return fixed_vector_detail::partition_point<CAPACITY>(this->slot(0), this->_current_size,
+                                                              [&](const K& k) { return this->_comp(k, key); });
+    }
+
+    /// @brief Get the index of the first key ordered after `key`
+    template <typename Key>
+    constexpr size_t upper_index(const Key& key) const {
+        return fixed_vector_detail::partition_point<CAPACITY>(this->slot(0), this->_current_size,
+                                                              [&](const K& k) { return !this->_comp(key, k); });
+    }
+
+    /// @brief Remove the key equivalent to `key`, if any
+    template <typename Key>
+    constexpr size_t erase_key(const Key& key) {
+        const size_t pos = this->find_index(key);
+        if (pos == this->_current_size) return 0;
+        fixed_vector_detail::shift_left(this->slot(0), this->_current_size, pos, 1);
+        --this->_current_size;
+        return 1;
+    }
+
+    /// @brief Get the index of `key`, or `_current_size` if it is not in the set
+    template <typename Key>
+    constexpr size_t find_index(const Key& key) const {
+        const size_t pos = this->lower_index(key);
+        return (pos != this->_current_size && !this->_comp(key, *this->slot(pos))) ? pos : this->_current_size;
+    }
+
+    /// @brief Insert `key` at its sorted position unless an equivalent key is already present
+    template <typename U>
+    constexpr std::pair<iterator, bool> insert_unique(U&& key) {
+        const size_t pos = this->lower_index(key);
+        if (pos != this->_current_size && !this->_comp(key, *this->slot(pos))) return {this->slot(pos), false};
+        fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full,
+                                           "Cannot insert", CAPACITY);
+        // Build the key first: it may refer to one of the keys about to move
+        K val(std::forward<U>(key));
+        fixed_vector_detail::shift_right(this->slot(0), this->_current_size, pos, 1);
+        std::construct_at(this->slot(pos), std::move(val));
+        ++this->_current_size;
+        return {this->slot(pos), true};
+    }
+
+public:
+    /// @brief Default constructor. Initial size will be 0
+    constexpr fixed_flat_set() : _current_size(0), _comp() {}
+
+    /// @brief Construct an empty set ordered by `comp`
+    constexpr explicit fixed_flat_set(const Compare& comp) : _current_size(0), _comp(comp) {}
+
+    /// @brief Initializer list constructor: the keys may come in any order, duplicates are dropped
+    constexpr fixed_flat_set(std::initializer_list<K> init_list) : fixed_flat_set() {
+        for (const K& key : init_list) this->insert(key);
+    }
+
+    /// @brief Copy constructor
+    constexpr fixed_flat_set(const fixed_flat_set& s) requires std::is_copy_constructible_v<K>
+        : _current_size(s._current_size), _comp(s._comp)
+    {
+        fixed_vector_detail::copy_construct_n(s.slot(0), s._current_size, this->slot(0));
+    }
+
+    /// @brief Move constructor. The keys of `s` are left in a moved-from state
+    constexpr fixed_flat_set(fixed_flat_set&& s) noexcept(std::is_nothrow_move_constructible_v<K>)
+        : _current_size(s._current_size), _comp(s._comp)
+    {
+        fixed_vector_detail::move_construct_n(s.slot(0), s._current_size, this->slot(0));
+    }
+
+    /// @brief Destructor for trivially destructible keys: nothing to do
+    constexpr ~fixed_flat_set() requires std::is_trivially_destructible_v<K> = default;
+
+    /// @brief Destructor: destroys every live key
+    constexpr ~fixed_flat_set() { this->destroy_from(0); }
+
+    /// @brief Allow another set to be copied into this one using the `=` operator
+    constexpr fixed_flat_set& operator= (const fixed_flat_set& s) requires std::is_copy_constructible_v<K> {
+        if (this == &s) return *this;
+        this->destroy_from(0);
+        fixed_vector_detail::copy_construct_n(s.slot(0), s._current_size, this->slot(0));
+        this->_current_size = s._current_size;
+        this->_comp = s._comp;
+        return *this;
+    }
+
+    /// @brief Allow another set to be moved into this one using the `=` operator
+    constexpr fixed_flat_set& operator= (fixed_flat_set&& s) noexcept(std::is_nothrow_move_constructible_v<K>) {
+        if (this == &s) return *this;
+        this->destroy_from(0);
+        fixed_vector_detail::move_construct_n(s.slot(0), s._current_size, this->slot(0));
+        this->_current_size = s._current_size;
+        this->_comp = s._comp;
+        return *this;
+    }
+
+    /// @brief Get the compile-time capacity of the set
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return CAPACITY; }
+
+    /// @brief Get the number of keys
+    [[nodiscard]] constexpr size_t size() const noexcept { return this->_current_size; }
+
+    /// @brief Whether the set holds no keys
+    [[nodiscard]] constexpr bool empty() const noexcept { return this->_current_size == 0; }
+
+    /// @brief Clear the set, destroying every key
+    constexpr void clear() { this->destroy_from(0); }
+
+    /// @brief Get a pointer to the sorted keys
+    [[nodiscard]] constexpr const K* data() const noexcept { return this->slot(0); }
+
+    /// @brief Get the ordering of the keys
+    [[nodiscard]] constexpr key_compare key_comp() const { return this->_comp; }
+
+    /// @brief Copy `key` into the set unless an equivalent key is already present
+    /// @return An iterator to the key equivalent to `key`, and whether it was inserted
+    constexpr std::pair<iterator, bool> insert(const K& key) { return this->insert_unique(key); }
+
+    /// @brief Move `key` into the set unless an equivalent key is already present
+    /// @return An iterator to the key equivalent to `key`, and whether it was inserted
+    constexpr std::pair<iterator, bool> insert(K&& key) { return this->insert_unique(std::move(key)); }
+
+    /// @brief Construct a key from `args` and insert it unless an equivalent key is already present
+    template <typename... Args>
+    constexpr std::pair<iterator, bool> emplace(Args&&... args) {
+        return this->insert_unique(K(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Insert every key of `[first, last)` that is not already present, with one shift of the existing keys
+     *
+     * The new keys are counted and checked against the capacity before anything is modified, then merged in a
+     * single pass. Of several equivalent keys in the range only the first is inserted. The merge leaves uninitialized
+     * slots among the keys while it runs, so if a copy or move of `K` may throw, the keys are inserted one at a time
+     * instead, and a throw leaves the set valid with a prefix of the new keys
+     * @param first,last A range sorted by `key_comp()`
+     */
+    template <std::forward_iterator It>
+    constexpr void insert_sorted(It first, It last) {
+        const auto id = [](const K& k) -> const K& { return k; };
+        const size_t added = fixed_vector_detail::count_new_keys(this->slot(0), this->_current_size, first, last,
+                                                                 this->_comp, id);
+        if (added == 0) return;
+        fixed_vector_detail::check<Policy>(added > CAPACITY - this->_current_size, fixed_vector_error::too_many,
+                                           "Cannot insert", this->_current_size + added, CAPACITY);
+        if constexpr (!NOTHROW_MERGE<It>) {
+            for (; first != last; ++first) this->insert_unique(*first);
+            return;
+        }
+        fixed_vector_detail::shift_right(this->slot(0), this->_current_size, 0, added);
+        fixed_vector_detail::merge_sorted(
+            this->slot(0), this->_current_size, added, first, last, this->_comp, id,
+            [&](size_t d, bool raw, It it) {
+                if (raw) std::construct_at(this->slot(d), *it);
+                else *this->slot(d) = *it;
+            },
+            [&](size_t d, bool raw, size_t from) {
+                if (raw) std::construct_at(this->slot(d), std::move(*this->slot(from)));
+                else *this->slot(d) = std::move(*this->slot(from));
+            });
+        this->_current_size = static_cast<size_type>(this->_current_size + added);
+    }
+
+    /// @brief Remove the key equivalent to `key`, if any
+    /// @return The number of keys removed, 0 or 1
+    constexpr size_t erase(const K& key) { return this->erase_key(key); }
+
+    /// @brief Remove the key equivalent to `key`, if any. Needs a transparent `Compare`
+    /// @return The number of keys removed, 0 or 1
+    template <typename Key>
+    constexpr size_t erase(const Key& key)
+        requires fixed_vector_detail::is_transparent<Compare> && (!std::is_convertible_v<const Key&, const_iterator>)
+    {
+        return this->erase_key(key);
+    }
+
+    /// @brief Remove the key at `pos`
+    /// @return An iterator to the key that followed it
+    constexpr iterator erase(const_iterator pos) {
+        const size_t index = static_cast<size_t>(pos - this->slot(0));
+        fixed_vector_detail::check<Policy>(index >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot erase", index, this->_current_size);
+        fixed_vector_detail::shift_left(this->slot(0), this->_current_size, index, 1);
+        --this->_current_size;
+        return this->slot(index);
+    }
+
+    /*
+     * Lookups take `const K&`, so that e.g. a string literal is converted to `K` once rather than on every comparison
+     * of the search. With a transparent `Compare`, such as `std::less<>`, they also accept any key type as is
+     */
+
+    /// @brief Get an iterator to the key equivalent to `key`, or `end()`
+    [[nodiscard]] constexpr const_iterator find(const K& key) const { return this->slot(this->find_index(key)); }
+
+    /// @brief Get an iterator to the key equivalent to `key`, or `end()`. Needs a transparent `Compare`
+    template <typename Key>
+    [[nodiscard]] constexpr const_iterator find(const Key& key) const
+        requires fixed_vector_detail::is_transparent<Compare>
+    {
+        return this->slot(this->find_index(key));
+    }
+
+    /// @brief Whether a key equivalent to `key` is in the set
+    [[nodiscard]] constexpr bool contains(const K& key) const { return this->find_index(key) != this->_current_size; }
+
+    /// @brief Whether a key equivalent to `key` is in the set. Needs a transparent `Compare`
+    template <typename Key>
+    [[nodiscard]] constexpr bool contains(const Key& key) const requires fixed_vector_detail::is_transparent<Compare> {
+        return this->find_index(key) != this->_current_size;
+    }
+
+    /// @brief Get the number of keys equivalent to `key`, 0 or 1
+    [[nodiscard]] constexpr size_t count(const K& key) const { return this->contains(key) ? 1 : 0; }
+
+    /// @brief Get the number of keys equivalent to `key`, 0 or 1. Needs a transparent `Compare`
+    template <typename Key>
+    [[nodiscard]] constexpr size_t count(const Key& key) const requires fixed_vector_detail::is_transparent<Compare> {
+        return this->contains(key) ? 1 : 0;
+    }
+
+    /// @brief Get an iterator to the first key not ordered before `key`
+    [[nodiscard]] constexpr const_iterator lower_bound(const K& key) const {
+        return this->slot(this->lower_index(key));
+    }
+
+    /// @brief Get an iterator to the first key not ordered before `key`. Needs a transparent `Compare`
+    template <typename Key>
+    [[nodiscard]] constexpr const_iterator lower_bound(const Key& key) const
+        requires fixed_vector_detail::is_transparent<Compare>
+    {
+        return this->slot(this->lower_index(key));
+    }
+
+    /// @brief Get an iterator to the first key ordered after `key`
+    [[nodiscard]] constexpr const_iterator upper_bound(const K& key) const {
+        return this->slot(this->upper_index(key));
+    }
+
+    /// @brief Get an iterator to the first key ordered after `key`. Needs a transparent `Compare`
+    template <typename Key>
+    [[nodiscard]] constexpr const_iterator upper_bound(const Key& key) const
+        requires fixed_vector_detail::is_transparent<Compare>
+    {
+        return this->slot(this->upper_index(key));
+    }
+
+    /// @brief Allow two `fixed_flat_set`s to be compared using `==`
+    constexpr bool operator== (const fixed_flat_set& s) const {
+        return this->_current_size == s._current_size && std::equal(this->cbegin(), this->cend(), s.cbegin());
+    }
+
+    /// @brief Get iterator to beginning
+    constexpr const_iterator begin() const { return this->slot(0); }
+
+    /// @brief Get iterator to end
+    constexpr const_iterator end() const { return this->slot(this->_current_size); }
+
+    /// @brief Get const iterator to beginning
+    constexpr const_iterator cbegin() const { return this->begin(); }
+
+    /// @brief Get const iterator to end
+    constexpr const_iterator cend() const { return this->end(); }
+
+    /// @brief Get reverse iterator to the last key
+    constexpr const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+
+    /// @brief Get reverse iterator to before the first key
+    constexpr const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+    /// @brief Get const reverse iterator to the last key
+    constexpr const_reverse_iterator crbegin() const { return this->rbegin(); }
+
+    /// @brief Get const reverse iterator to before the first key
+    constexpr const_reverse_iterator crend() const { return this->rend(); }
+};
+
+#endif //FIXED_FLAT_SET_HPP
@@ -0,0 +1,505 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef FIXED_HASH_MAP_HPP
+#define FIXED_HASH_MAP_HPP
+
+#include "fixed_vector.hpp"
+
+#include <bit>
+#include <functional>
+#include <utility>
+
+namespace fixed_vector_detail {
+    /// @brief The number of control bytes scanned at once
+    inline constexpr size_t CTRL_GROUP_SIZE = 16;
+    /// @brief Control byte of a slot that never held an element since the last rehash: stops a probe
+    inline constexpr std::int8_t CTRL_EMPTY = -128;
+    /// @brief Control byte of a slot whose element was erased: a probe continues past it
+    inline constexpr std::int8_t CTRL_DELETED = -2;
+
+    /// @brief Get a bitmask of the control bytes in the 16-byte aligned group `group` that are equal to `value`
+    inline unsigned ctrl_match(const std::int8_t* group, std::int8_t value) noexcept {
+#if FIXED_VECTOR_SSE2
+        const __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value))));
+#else
+        unsigned mask = 0;
+        for (size_t i = 0; i < CTRL_GROUP_SIZE; ++i) mask |= static_cast<unsigned>(group[i] == value) << i;
+        return mask;
+#endif
+    }
+
+    /// @brief Get a bitmask of the control bytes in the 16-byte aligned group `group` that are empty or deleted
+    inline unsigned ctrl_match_free(const std::int8_t* group) noexcept {
+#if FIXED_VECTOR_SSE2
+        // Full slots hold a 7-bit hash, so the free ones are exactly those with the sign bit set
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+        unsigned mask = 0;
+        for (size_t i = 0; i < CTRL_GROUP_SIZE; ++i) mask |= static_cast<unsigned>(group[i] < 0) << i;
+        return mask;
+#endif
+    }
+
+    /// @brief Spread the entropy of a hash over all 64 bits, as `std::hash` is the identity for integers
+    constexpr std::uint64_t mix_hash(std::uint64_t h) noexcept {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        return h;
+    }
+}
+
+/**
+ * @class fixed_hash_map
+ * @brief An open-addressing hash map of at most `CAPACITY` entries in inline storage, no dynamic memory allocation
+ *
+ * Laid out like a Swiss table: one control byte per slot holds 7 bits of the hash of a full slot, or marks it empty or
+ * deleted, and lookups compare a 16-byte group of control bytes at a time with SSE2 before touching any key. Groups
+ * are probed triangularly. The slot count is the smallest power of two keeping the load factor at or below 7/8 when
+ * `CAPACITY` entries are stored.
+ *
+ * Erasing only leaves a tombstone when the slot's group has no empty slot, because only then can a probe have passed
+ * through it. Tombstones are dropped by an in-place rehash once they would push the load past 7/8
+ * @tparam K The key type
+ * @tparam V The mapped type
+ * @tparam CAPACITY The maximum number of entries
+ * @tparam Hash The hash function of the keys
+ * @tparam KeyEqual The equality of the keys
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types
+ */
+template <typename K, typename V, size_t CAPACITY, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Policy = fixed_vector_policy::default_policy>
+class fixed_hash_map {
+    static_assert(CAPACITY > 0, "Capacity cannot be 0");
+
+    static constexpr size_t GROUP = fixed_vector_detail::CTRL_GROUP_SIZE;
+    static constexpr size_t SLOTS = std::max(GROUP, std::bit_ceil(CAPACITY + (CAPACITY + 6) / 7));
+    static constexpr size_t GROUPS = SLOTS / GROUP;
+    /// @brief The most slots that may be full or deleted before an insertion rehashes
+    static constexpr size_t MAX_LOAD = SLOTS - SLOTS / 8;
+    static_assert(CAPACITY <= MAX_LOAD, "The load factor cap must leave room for CAPACITY entries");
+
+public:
+    /// @brief The type used to store the logical size: the smallest unsigned type that can hold `SLOTS`
+    using size_type = fixed_vector_detail::smallest_size_t<SLOTS>;
+    using key_type = K;
+    using mapped_type = V;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    /// @brief An entry by value
+    using value_type = std::pair<K, V>;
+    /// @brief A proxy reference to an entry: the key is never mutable
+    using reference = std::pair<const K&, V&>;
+    /// @brief A proxy const reference to an entry
+    using const_reference = std::pair<const K&, const V&>;
+
+private:
+    /// @brief The number of entries
+    size_type _current_size;
+    /// @brief The number of deleted slots
+    size_type _tombstones;
+    [[no_unique_address]] Hash _hash;
+    [[no_unique_address]] KeyEqual _eq;
+    /// @brief One control byte per slot: `CTRL_EMPTY`, `CTRL_DELETED`, or the low 7 bits of the hash of a full slot
+    alignas(16) std::int8_t _ctrl[SLOTS];
+    /// @brief Uninitialized storage for the keys. Only full slots hold objects
+    fixed_vector_detail::storage<K, SLOTS> _keys;
+    /// @brief Uninitialized storage for the values, parallel to the keys
+    fixed_vector_detail::storage<V, SLOTS> _values;
+
+    K* key_slot(size_t pos) noexcept { return this->_keys.data() + pos; }
+    const K* key_slot(size_t pos) const noexcept { return this->_keys.data() + pos; }
+    V* value_slot(size_t pos) noexcept { return this->_values.data() + pos; }
+    const V* value_slot(size_t pos) const noexcept { return this->_values.data() + pos; }
+
+    bool is_full(size_t pos) const noexcept { return this->_ctrl[pos] >= 0; }
+
+    template <typename Key>
+    std::uint64_t hash_of(const Key& key) const {
+        return fixed_vector_detail::mix_hash(static_cast<std::uint64_t>(this->_hash(key)));
+    }
+
+    static std::int8_t h2(std::uint64_t h) noexcept { return static_cast<std::int8_t>(h & 0x7F); }
+    static size_t first_group(std::uint64_t h) noexcept { return static_cast<size_t>(h >> 7) & (GROUPS - 1); }
+
+    /// @brief Get the index of `key`, or `SLOTS` if it is not in the map
+    template <typename Key>
+    size_t find_index(const Key& key, std::uint64_t h) const {
+        size_t g = first_group(h);
+        for (size_t step = 1; step <= GROUPS; ++step) {
+            const std::int8_t* group = this->_ctrl + g * GROUP;
+            for (unsigned m = fixed_vector_detail::ctrl_match(group, h2(h)); m != 0; m &= m - 1) {
+                const size_t pos = g * GROUP + std::countr_zero(m);
+                if (this->_eq(*this->key_slot(pos), key)) [[likely]] return pos;
+            }
+            if (fixed_vector_detail::ctrl_match(group, fixed_vector_detail::CTRL_EMPTY) != 0) return SLOTS;
+            g = (g + step) & (GROUPS - 1);
+        }
+        return SLOTS;
+    }
+
+    /// @brief Get the first empty or deleted slot on the probe sequence of `h`. There always is one
+    size_t find_free(std::uint64_t h) const noexcept {
+        size_t g = first_group(h);
+        for (size_t step = 1;; ++step) {
+            const unsigned m = fixed_vector_detail::ctrl_match_free(this->_ctrl + g * GROUP);
+            if (m != 0) return g * GROUP + std::countr_zero(m);
+            g = (g + step) & (GROUPS - 1);
+        }
+    }
+
+    /// @brief Destroy the entry at `pos`, leaving its control byte to the caller
+    void destroy_at(size_t pos) noexcept {
+        std::destroy_at(this->key_slot(pos));
+        std::destroy_at(this->value_slot(pos));
+    }
+
+    /// @brief Move the entry at `from` into the raw slot `to`, destroying the source
+    void relocate(size_t from, size_t to) {
+        std::construct_at(this->key_slot(to), std::move(*this->key_slot(from)));
+        std::construct_at(this->value_slot(to), std::move(*this->value_slot(from)));
+        this->destroy_at(from);
+    }
+
+    /**
+     * @brief Drop every tombstone by reinserting the entries in place, without any extra storage
+     *
+     * Every full slot is first marked deleted, meaning "not placed yet", and every deleted one empty. Each unplaced
+     * entry then goes to the first free slot on its probe sequence: it stays put if that slot is in its own group,
+     * moves if the slot is empty, or swaps with the unplaced entry there, which is processed next
+     */
+    [[gnu::noinline]] void drop_tombstones() {
+        using fixed_vector_detail::CTRL_DELETED;
+        using fixed_vector_detail::CTRL_EMPTY;
+        for (std::int8_t& c : this->_ctrl) c = c >= 0 ? CTRL_DELETED : CTRL_EMPTY;
+        for (size_t pos = 0; pos < SLOTS; ++pos) {
+            if (this->_ctrl[pos] != CTRL_DELETED) continue;
+            const std::uint64_t h = this->hash_of(*this->key_slot(pos));
+            const size_t target = this->find_free(h);
+            if (target / GROUP == pos / GROUP) {
+                this->_ctrl[pos] = h2(h);
+            } else if (this->_ctrl[target] == CTRL_EMPTY) {
+                this->relocate(pos, target);
+                this->_ctrl[target] = h2(h);
+                this->_ctrl[pos] = CTRL_EMPTY;
+            } else {
+                using std::swap;
+                swap(*this->key_slot(pos), *this->key_slot(target));
+                swap(*this->value_slot(pos), *this->value_slot(target));
+                this->_ctrl[target] = h2(h);
+                --pos;
+            }
+        }
+        this->_tombstones = 0;
+    }
+
+    /// @brief Construct the value of the entry whose key was just built at `pos`, destroying that key if this throws
+    template <typename... Args>
+    void construct_value(size_t pos, Args&&... args) {
+#if FIXED_VECTOR_EXCEPTIONS
+        try {
+            std::construct_at(this->value_slot(pos), std::forward<Args>(args)...);
+        } catch (...) {
+            std::destroy_at(this->key_slot(pos));
+            throw;
+        }
+#else
+        std::construct_at(this->value_slot(pos), std::forward<Args>(args)...);
+#endif
+    }
+
+    /// @brief Get the value of `key`, inserting it with a value built from `args` first if it is missing
+    template <typename KeyArg, typename... Args>
+    std::pair<V*, bool> try_emplace_impl(KeyArg&& key, Args&&... args) {
+        const std::uint64_t h = this->hash_of(key);
+        const size_t found = this->find_index(key, h);
+        if (found != SLOTS) return {this->value_slot(found), false};
+        fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full,
+                                           "Cannot insert", CAPACITY);
+        size_t pos;
+        if (this->_current_size + this->_tombstones >= MAX_LOAD) [[unlikely]] {
+            // Build the entry first: the arguments may refer to entries that are about to move
+            K k(std::forward<KeyArg>(key));
+            V v(std::forward<Args>(args)...);
+            this->drop_tombstones();
+            pos = this->find_free(h);
+            std::construct_at(this->key_slot(pos), std::move(k));
+            this->construct_value(pos, std::move(v));
+        } else {
+            pos = this->find_free(h);
+            std::construct_at(this->key_slot(pos), std::forward<KeyArg>(key));
+            this->construct_value(pos, std::forward<Args>(args)...);
+        }
+        if (this->_ctrl[pos] == fixed_vector_detail::CTRL_DELETED) --this->_tombstones;
+        this->_ctrl[pos] = h2(h);
+        ++this->_current_size;
+        return {this->value_slot(pos), true};
+    }
+
+    /**
+     * @brief Copy or move every entry of `m` into this empty map, slot for slot
+     *
+     * Each slot is marked full as soon as its entry is built, so if an entry throws, `clear()` finds and destroys the
+     * ones built so far before rethrowing: the copy and move constructors call this, and a constructor that throws
+     * never reaches the destructor
+     */
+    template <bool MOVE, typename Other>
+    void construct_from(Other& m) {
+        std::memset(this->_ctrl, fixed_vector_detail::CTRL_EMPTY, SLOTS);
+        const auto build = [&] {
+            for (size_t pos = 0; pos < SLOTS; ++pos) {
+                if (!m.is_full(pos)) continue;
+                if constexpr (MOVE) {
+                    std::construct_at(this->key_slot(pos), std::move(*m.key_slot(pos)));
+                    this->construct_value(pos, std::move(*m.value_slot(pos)));
+                } else {
+                    std::construct_at(this->key_slot(pos), *m.key_slot(pos));
+                    this->construct_value(pos, *m.value_slot(pos));
+                }
+                this->_ctrl[pos] = m._ctrl[pos];
+                ++this->_current_size;
+            }
+        };
+#if FIXED_VECTOR_EXCEPTIONS
+        try {
+            build();
+        } catch (...) {
+            this->clear();
+            throw;
+        }
+#else
+        build();
+#endif
+        std::memcpy(this->_ctrl, m._ctrl, SLOTS);
+        this->_tombstones = m._tombstones;
+    }
+
+public:
+    /// @brief Default constructor. Initial size will be 0
+    fixed_hash_map() : _current_size(0), _tombstones(0), _hash(), _eq() {
+        std::memset(this->_ctrl, fixed_vector_detail::CTRL_EMPTY, SLOTS);
+    }
+
+    /// @brief Initializer list constructor: only the first of equivalent keys is kept
+    fixed_hash_map(std::initializer_list<value_type> init_list) : fixed_hash_map() {
+        for (const value_type& entry : init_list) this->try_emplace(entry.first, entry.second);
+    }
+
+    /// @brief Copy constructor
+    fixed_hash_map(const fixed_hash_map& m)
+        requires (std::is_copy_constructible_v<K> && std::is_copy_constructible_v<V>)
+        : _current_size(0), _tombstones(0), _hash(m._hash), _eq(m._eq)
+    {
+        this->construct_from<false>(m);
+    }
+
+    /// @brief Move constructor. The entries of `m` are left in a moved-from state
+    fixed_hash_map(fixed_hash_map&& m)
+        noexcept(std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>)
+        : _current_size(0), _tombstones(0), _hash(m._hash), _eq(m._eq)
+    {
+        this->construct_from<true>(m);
+    }
+
+    /// @brief Destructor: destroys every live entry
+    ~fixed_hash_map() { this->clear(); }
+
+    /// @brief Allow another map to be copied into this one using the `=` operator
+    fixed_hash_map& operator= (const fixed_hash_map& m)
+        requires (std::is_copy_constructible_v<K> && std::is_copy_constructible_v<V>)
+    {
+        if (this == &m) return *this;
+        this->clear();
+        this->construct_from<false>(m);
+        return *this;
+    }
+
+    /// @brief Allow another map to be moved into this one using the `=` operator
+    fixed_hash_map& operator= (fixed_hash_map&& m)
+        noexcept(std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>)
+    {
+        if (this == &m) return *this;
+        this->clear();
+        this->construct_from<true>(m);
+        return *this;
+    }
+
+    /// @brief Get the maximum number of entries
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return CAPACITY; }
+
+    /// @brief Get the number of slots, a power of two with at least 1/8 of them always free
+    [[nodiscard]] static constexpr size_t slot_count() noexcept { return SLOTS; }
+
+    /// @brief Get the number of entries
+    [[nodiscard]] size_t size() const noexcept { return this->_current_size; }
+
+    /// @brief Whether the map holds no entries
+    [[nodiscard]] bool empty() const noexcept { return this->_current_size == 0; }
+
+    /// @brief Clear the map, destroying every entry and every tombstone
+    void clear() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<K> || !std::is_trivially_destructible_v<V>) {
+            for (size_t pos = 0; pos < SLOTS && this->_current_size != 0; ++pos) {
+                if (!this->is_full(pos)) continue;
+                this->destroy_at(pos);
+                --this->_current_size;
+            }
+        }
+        std::memset(this->_ctrl, fixed_vector_detail::CTRL_EMPTY, SLOTS);
+        this->_current_size = 0;
+        this->_tombstones = 0;
+    }
+
+    /// @brief Insert `key` with a value constructed from `args`, unless an equal key is already present
+    /// @return A pointer to the value of the key equal to `key`, and whether it was inserted
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(const K& key, Args&&... args) {
+        return this->try_emplace_impl(key, std::forward<Args>(args)...);
+    }
+
+    /// @brief Insert `key` with a value constructed from `args`, unless an equal key is already present
+    /// @return A pointer to the value of the key equal to `key`, and whether it was inserted
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(K&& key, Args&&... args) {
+        return this->try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+    }
+
+    /// @brief Insert `key` with `val`, or assign `val` to the value of an equal key already present
+    /// @return A pointer to the value of the key equal to `key`, and whether it was inserted
+    template <typename M>
+    std::pair<V*, bool> insert_or_assign(const K& key, M&& val) {
+        if (V* found = this->find(key)) {
+            *found = std::forward<M>(val);
+            return {found, false};
+        }
+        return this->try_emplace_impl(key, std::forward<M>(val));
+    }
+
+    /// @brief Get the value of `key`, inserting a value-initialized one first if it is missing
+    V& operator[](const K& key) requires std::is_default_constructible_v<V> {
+        return *this->try_emplace_impl(key).first;
+    }
+
+    /// @brief Remove the entry with a key equal to `key`, if any
+    /// @return The number of entries removed, 0 or 1
+    template <typename Key = K>
+    size_t erase(const Key& key) {
+        const size_t pos = this->find_index(key, this->hash_of(key));
+        if (pos == SLOTS) return 0;
+        this->destroy_at(pos);
+        // A group with an empty slot always stopped every probe reaching it, so no probe continues past this slot
+        const std::int8_t* group = this->_ctrl + pos / GROUP * GROUP;
+        if (fixed_vector_detail::ctrl_match(group, fixed_vector_detail::CTRL_EMPTY) != 0) {
+            this->_ctrl[pos] = fixed_vector_detail::CTRL_EMPTY;
+        } else {
+            this->_ctrl[pos] = fixed_vector_detail::CTRL_DELETED;
+            ++this->_tombstones;
+        }
+        --this->_current_size;
+        return 1;
+    }
+
+    /// @brief Get a pointer to the value of `key`, or `nullptr` if it is missing
+    template <typename Key = K>
+    [[nodiscard]] V* find(const Key& key) {
+        const size_t pos = this->find_index(key, this->hash_of(key));
+        return pos == SLOTS ? nullptr : this->value_slot(pos);
+    }
+
+    /// @brief Get a const pointer to the value of `key`, or `nullptr` if it is missing
+    template <typename Key = K>
+    [[nodiscard]] const V* find(const Key& key) const {
+        const size_t pos = this->find_index(key, this->hash_of(key));
+        return pos == SLOTS ? nullptr : this->value_slot(pos);
+    }
+
+    /// @brief Whether a key equal to `key` is in the map
+    template <typename Key = K>
+    [[nodiscard]] bool contains(const Key& key) const { return this->find(key) != nullptr; }
+
+    /// @brief Get the number of keys equal to `key`, 0 or 1
+    template <typename Key = K>
+    [[nodiscard]] size_t count(const Key& key) const { return this->contains(key) ? 1 : 0; }
+
+    /// @brief Allow two `fixed_hash_map`s to be compared using `==`: same keys mapped to equal values
+    bool operator== (const fixed_hash_map& m) const {
+        if (this->_current_size != m._current_size) return false;
+        for (size_t pos = 0; pos < SLOTS; ++pos) {
+            if (!this->is_full(pos)) continue;
+            const V* other = m.find(*this->key_slot(pos));
+            if (other == nullptr || !(*other == *this->value_slot(pos))) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @class basic_iterator
+     * @brief Iterates over entries in slot order, dereferencing to a pair of references
+     *
+     * Dereferencing yields a proxy rather than a real reference, so this only models an input iterator for the
+     * classic algorithms
+     * @tparam CONST Whether the iterator gives const access to the values
+     */
+    template <bool CONST>
+    class basic_iterator {
+        using map_type = std::conditional_t<CONST, const fixed_hash_map, fixed_hash_map>;
+
+        map_type* _map;
+        size_t _pos;
+
+        void skip_free() {
+            while (this->_pos < SLOTS && !this->_map->is_full(this->_pos)) ++this->_pos;
+        }
+    public:
+        using value_type = fixed_hash_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<CONST, const_reference, fixed_hash_map::reference>;
+        using iterator_category = std::input_iterator_tag;
+
+        basic_iterator() : _map(nullptr), _pos(0) {}
+        basic_iterator(map_type* map, size_t pos) : _map(map), _pos(pos) { this->skip_free(); }
+
+        reference operator*() const {
+            return reference(*this->_map->key_slot(this->_pos), *this->_map->value_slot(this->_pos));
+        }
+
+        basic_iterator& operator++() {
+            ++this->_pos;
+            this->skip_free();
+            return *this;
+        }
+        basic_iterator operator++(int) { basic_iterator tmp = *this; ++*this; return tmp; }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) {
+            return lhs._pos == rhs._pos;
+        }
+    };
+
+    /// @brief Mutable entry iterator type
+    using iterator = basic_iterator<false>;
+    /// @brief Const entry iterator type
+    using const_iterator = basic_iterator<true>;
+
+    /// @brief Get mutable iterator to the first entry
+    iterator begin() { return iterator(this, 0); }
+
+    /// @brief Get mutable iterator past the last entry
+    iterator end() { return iterator(this, SLOTS); }
+
+    /// @brief Get const iterator to the first entry
+    const_iterator cbegin() const { return const_iterator(this, 0); }
+
+    /// @brief Get const iterator past the last entry
+    const_iterator cend() const { return const_iterator(this, SLOTS); }
+
+    /// @brief Overload for getting const iterator to the first entry
+    const_iterator begin() const { return cbegin(); }
+
+    /// @brief Overload for getting const iterator past the last entry
+    const_iterator end() const { return cend(); }
+};
+
+#endif //FIXED_HASH_MAP_HPP
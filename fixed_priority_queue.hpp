@@ -0,0 +1,400 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef FIXED_PRIORITY_QUEUE_HPP
+#define FIXED_PRIORITY_QUEUE_HPP
+
+#include "fixed_vector.hpp"
+
+#include <functional>
+#include <iterator>
+
+/**
+ * @class fixed_priority_queue
+ * @brief A d-ary heap of at most `CAPACITY` elements with no dynamic memory allocation
+ *
+ * Like `std::priority_queue<T, std::vector<T>, Compare>`, `top()` is the greatest element according to `Compare`.
+ * With the default arity of 4 a node's children share a cache line for small `T` and the tree is half as deep as a
+ * binary heap, which makes `pop()` cheaper. Sifting moves elements into a hole rather than swapping them.
+ *
+ * With `HANDLES`, every pushed element gets a handle that stays valid until the element is popped or erased, so its
+ * priority can be changed in place with `update()` (decrease-key) or it can be removed with `erase()`. Handles of
+ * removed elements are reused by later pushes. Tracking them costs two extra stores per element moved, so it is off
+ * by default
+ * @tparam T The element type
+ * @tparam CAPACITY The compile-time capacity of the queue
+ * @tparam Compare The strict weak ordering; the greatest element is on top
+ * @tparam ARITY The number of children per node, 2 for a binary heap
+ * @tparam HANDLES Whether to track handles for `get()`, `update()` and `erase()`
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types
+ */
+template <typename T, size_t CAPACITY, typename Compare = std::less<T>, size_t ARITY = 4, bool HANDLES = false,
+          typename Policy = fixed_vector_policy::default_policy>
+class fixed_priority_queue {
+    static_assert(CAPACITY > 0, "Capacity cannot be 0");
+    static_assert(ARITY >= 2, "A heap needs at least 2 children per node");
+
+public:
+    /// @brief The type used to store the logical size: the smallest unsigned type that can hold `CAPACITY`
+    using size_type = fixed_vector_detail::smallest_size_t<CAPACITY>;
+    /// @brief Identifies a pushed element until it is popped or erased
+    using handle_type = size_type;
+    /// @brief What `push()` returns: a handle if they are tracked
+    using push_result = std::conditional_t<HANDLES, handle_type, void>;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using value_compare = Compare;
+
+private:
+    /// @brief The current number of elements
+    size_type _current_size;
+    /// @brief The number of distinct handles ever given out. Handles at or past this have no position yet
+    size_type _handles_used;
+    /// @brief The ordering of the elements
+    [[no_unique_address]] Compare _comp;
+    /// @brief Uninitialized storage for the heap-ordered elements. Only the first `_current_size` slots hold objects
+    fixed_vector_detail::storage<T, CAPACITY> _buf;
+    /// @brief The handle of the element at each heap position. Past `_current_size`, the free handles
+    fixed_vector_detail::storage<size_type, HANDLES ? CAPACITY : 1> _handle_at;
+    /// @brief The heap position of each handle
+    fixed_vector_detail::storage<size_type, HANDLES ? CAPACITY : 1> _pos_of;
+
+    constexpr T* slot(size_t pos) noexcept { return this->_buf.data() + pos; }
+    constexpr const T* slot(size_t pos) const noexcept { return this->_buf.data() + pos; }
+
+    /// @brief Record that handle `h` is at heap position `pos`
+    constexpr void place_handle(size_t pos, size_type h) noexcept {
+        if constexpr (HANDLES) {
+            this->_handle_at.data()[pos] = h;
+            this->_pos_of.data()[h] = static_cast<size_type>(pos);
+        }
+    }
+
+    /// @brief Get the handle of the element at heap position `pos`, or 0 if handles are not tracked
+    constexpr size_type handle_at(size_t pos) const noexcept {
+        if constexpr (HANDLES) return this->_handle_at.data()[pos];
+        else return 0;
+    }
+
+    /// @brief Get a handle for a new element, reusing the handle of a removed one if there is any
+    constexpr size_type next_handle() noexcept {
+        if constexpr (HANDLES) {
+            if (this->_current_size == this->_handles_used) return this->_handles_used++;
+            return this->_handle_at.data()[this->_current_size];
+        } else {
+            return 0;
+        }
+    }
+
+    /**
+     * @brief Get whichever of the positions `a` and `b` holds the greater element
+     *
+     * Which child wins is a coin flip on most workloads, so the pick is a mask rather than a branch that would
+     * mispredict half the time
+     */
+    constexpr size_t greater_of(size_t a, size_t b) const {
+        const size_t after = this->_comp(*this->slot(a), *this->slot(b));
+        return a + ((b - a) & (0 - after));
+    }
+
+    /// @brief Get the index of the greatest of the `COUNT` elements from `first`, playing them off in pairs so the
+    /// comparisons of one round do not wait on each other
+    template <size_t COUNT>
+    constexpr size_t tournament(size_t first) const {
+        if constexpr (COUNT == 1) {
+            return first;
+        } else {
+            const size_t left = this->tournament<COUNT / 2>(first);
+            const size_t right = this->tournament<COUNT - COUNT / 2>(first + COUNT / 2);
+            return this->greater_of(left, right);
+        }
+    }
+
+    /// @brief Get the index of the greatest of the children `[first, end)`
+    constexpr size_t best_child(size_t first, size_t end) const {
+        if (end - first == ARITY) return this->tournament<ARITY>(first);
+        size_t best = first;
+        for (size_t c = first + 1; c < end; ++c) best = this->greater_of(best, c);
+        return best;
+    }
+
+    /**
+     * @brief Move the element at `pos` up until its parent is not ordered before it
+     * @return The final position of the element
+     */
+    constexpr size_t sift_up(size_t pos) {
+        const size_type h = this->handle_at(pos);
+        T val = std::move(*this->slot(pos));
+        while (pos > 0) {
+            const size_t parent = (pos - 1) / ARITY;
+            if (!this->_comp(*this->slot(parent), val)) break;
+            *this->slot(pos) = std::move(*this->slot(parent));
+            this->place_handle(pos, this->handle_at(parent));
+            pos = parent;
+        }
+        *this->slot(pos) = std::move(val);
+        this->place_handle(pos, h);
+        return pos;
+    }
+
+    /// @brief Move the element at `pos` down until none of its children is ordered after it
+    constexpr void sift_down(size_t pos) {
+        const size_type h = this->handle_at(pos);
+        T val = std::move(*this->slot(pos));
+        const size_t size = this->_current_size;
+        for (;;) {
+            const size_t first = pos * ARITY + 1;
+            if (first >= size) break;
+            const size_t best = this->best_child(first, std::min(first + ARITY, size));
+            if (!this->_comp(val, *this->slot(best))) break;
+            *this->slot(pos) = std::move(*this->slot(best));
+            this->place_handle(pos, this->handle_at(best));
+            pos = best;
+        }
+        *this->slot(pos) = std::move(val);
+        this->place_handle(pos, h);
+    }
+
+    /// @brief Walk a hole at `hole` down to a leaf of the first `size` elements, promoting the greatest child at each
+    /// level without comparing against the element that will fill it
+    /// @return The final position of the hole
+    constexpr size_t walk_hole_down(size_t hole, size_t size) {
+        for (;;) {
+            const size_t first = hole * ARITY + 1;
+            if (first >= size) return hole;
+            const size_t best = this->best_child(first, std::min(first + ARITY, size));
+            *this->slot(hole) = std::move(*this->slot(best));
+            this->place_handle(hole, this->handle_at(best));
+            hole = best;
+        }
+    }
+
+    /// @brief Restore the heap order of the element at `pos` after its value changed either way
+    constexpr void restore(size_t pos) {
+        if (this->sift_up(pos) == pos) this->sift_down(pos);
+    }
+
+    /**
+     * @brief Remove the element at heap position `pos` and return it
+     *
+     * The hole left at `pos` is first walked down to a leaf by promoting the greatest child at each level, without
+     * comparing against the last element. The last element then fills the hole and sifts up, which is usually only a
+     * step or two since it came from the bottom of the heap
+     * @warning DOES NOT BOUNDS CHECK
+     */
+    constexpr T unchecked_remove_at(size_t pos) {
+        const size_t last = this->_current_size - 1;
+        const size_type h = this->handle_at(pos);
+        T val = std::move(*this->slot(pos));
+        size_t hole = pos;
+        if (pos != last) {
+            hole = this->walk_hole_down(pos, last);
+            *this->slot(hole) = std::move(*this->slot(last));
+            this->place_handle(hole, this->handle_at(last));
+        }
+        std::destroy_at(this->slot(last));
+        // Park the freed handle just past the live ones for `next_handle`
+        if constexpr (HANDLES) this->_handle_at.data()[last] = h;
+        this->_current_size = static_cast<size_type>(last);
+        if (pos != last) this->sift_up(hole);
+        return val;
+    }
+
+    /// @brief Get the heap position of handle `h`, checking that it refers to a live element
+    constexpr size_t position_of(handle_type h, const char* what) const requires HANDLES {
+        const bool live = h < this->_handles_used && this->_pos_of.data()[h] < this->_current_size &&
+                          this->_handle_at.data()[this->_pos_of.data()[h]] == h;
+        fixed_vector_detail::check<Policy>(!live, fixed_vector_error::out_of_range, what, h, this->_current_size);
+        return this->_pos_of.data()[h];
+    }
+
+    /// @brief Copy or move every element and handle of `q` into this empty queue
+    template <bool MOVE, typename Other>
+    constexpr void construct_from(Other& q) {
+        if constexpr (MOVE) fixed_vector_detail::move_construct_n(q.slot(0), q._current_size, this->slot(0));
+        else fixed_vector_detail::copy_construct_n(q.slot(0), q._current_size, this->slot(0));
+        if constexpr (HANDLES) {
+            fixed_vector_detail::copy_construct_n(q._handle_at.data(), q._handles_used, this->_handle_at.data());
+            fixed_vector_detail::copy_construct_n(q._pos_of.data(), q._handles_used, this->_pos_of.data());
+        }
+        this->_current_size = q._current_size;
+        this->_handles_used = q._handles_used;
+        this->_comp = q._comp;
+    }
+
+public:
+    /// @brief Default constructor. Initial size will be 0
+    constexpr fixed_priority_queue() : _current_size(0), _handles_used(0), _comp() {}
+
+    /// @brief Construct an empty queue ordered by `comp`
+    constexpr explicit fixed_priority_queue(const Compare& comp) : _current_size(0), _handles_used(0), _comp(comp) {}
+
+    /// @brief Construct a queue from the elements of `[first, last)` with a single O(n) heapify
+    template <std::forward_iterator It>
+    constexpr fixed_priority_queue(It first, It last, const Compare& comp = Compare())
+        : _current_size(0), _handles_used(0), _comp(comp)
+    {
+        this->push_range(first, last);
+    }
+
+    /// @brief Copy constructor. Handles keep referring to the same elements in the copy
+    constexpr fixed_priority_queue(const fixed_priority_queue& q) requires std::is_copy_constructible_v<T>
+        : _current_size(0), _handles_used(0), _comp(q._comp)
+    {
+        this->construct_from<false>(q);
+    }
+
+    /// @brief Move constructor. The elements of `q` are left in a moved-from state
+    constexpr fixed_priority_queue(fixed_priority_queue&& q) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : _current_size(0), _handles_used(0), _comp(q._comp)
+    {
+        this->construct_from<true>(q);
+    }
+
+    /// @brief Destructor for trivially destructible types: nothing to do
+    constexpr ~fixed_priority_queue() requires std::is_trivially_destructible_v<T> = default;
+
+    /// @brief Destructor: destroys every live element
+    constexpr ~fixed_priority_queue() { this->clear(); }
+
+    /// @brief Allow another queue to be copied into this one using the `=` operator
+    constexpr fixed_priority_queue& operator= (const fixed_priority_queue& q) requires std::is_copy_constructible_v<T> {
+        if (this == &q) return *this;
+        this->clear();
+        this->construct_from<false>(q);
+        return *this;
+    }
+
+    /// @brief Allow another queue to be moved into this one using the `=` operator
+    constexpr fixed_priority_queue& operator= (fixed_priority_queue&& q)
+        noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this == &q) return *this;
+        this->clear();
+        this->construct_from<true>(q);
+        return *this;
+    }
+
+    /// @brief Get the compile-time capacity of the queue
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return CAPACITY; }
+
+    /// @brief Get the number of children per node
+    [[nodiscard]] static constexpr size_t arity() noexcept { return ARITY; }
+
+    /// @brief Get the number of elements
+    [[nodiscard]] constexpr size_t size() const noexcept { return this->_current_size; }
+
+    /// @brief Whether the queue holds no elements
+    [[nodiscard]] constexpr bool empty() const noexcept { return this->_current_size == 0; }
+
+    /// @brief Clear the queue, destroying every element and invalidating every handle
+    constexpr void clear() noexcept {
+        std::destroy(this->slot(0), this->slot(this->_current_size));
+        this->_current_size = 0;
+        this->_handles_used = 0;
+    }
+
+    /// @brief Get the greatest element
+    [[nodiscard]] constexpr const T& top() const {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot access");
+        return *this->slot(0);
+    }
+
+    /// @brief Get the handle of the greatest element
+    [[nodiscard]] constexpr handle_type top_handle() const requires HANDLES {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot access");
+        return this->_handle_at.data()[0];
+    }
+
+    /// @brief Construct an element in place and sift it up
+    /// @return The handle of the new element, if handles are tracked
+    template <typename... Args>
+    constexpr push_result emplace(Args&&... args) {
+        fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full,
+                                           "Cannot push", CAPACITY);
+        const size_type h = this->next_handle();
+        const size_t pos = this->_current_size;
+        std::construct_at(this->slot(pos), std::forward<Args>(args)...);
+        this->place_handle(pos, h);
+        ++this->_current_size;
+        this->sift_up(pos);
+        if constexpr (HANDLES) return h;
+    }
+
+    /// @brief Copy an element into the queue
+    /// @return The handle of the new element, if handles are tracked
+    constexpr push_result push(const T& val) { return this->emplace(val); }
+
+    /// @brief Move an element into the queue
+    /// @return The handle of the new element, if handles are tracked
+    constexpr push_result push(T&& val) { return this->emplace(std::move(val)); }
+
+    /**
+     * @brief Add every element of `[first, last)`, then restore the heap order once with Floyd's O(n) heapify
+     *
+     * The capacity is checked once for the whole range before anything is added
+     */
+    template <std::forward_iterator It>
+    constexpr void push_range(It first, It last) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        fixed_vector_detail::check<Policy>(count > CAPACITY - this->_current_size, fixed_vector_error::too_many,
+                                           "Cannot push", this->_current_size + count, CAPACITY);
+        for (; first != last; ++first) {
+            const size_t pos = this->_current_size;
+            std::construct_at(this->slot(pos), *first);
+            this->place_handle(pos, this->next_handle());
+            ++this->_current_size;
+        }
+        if (this->_current_size < 2) return;
+        for (size_t pos = (this->_current_size - 2) / ARITY + 1; pos-- > 0;) this->sift_down(pos);
+    }
+
+    /// @brief Remove the greatest element
+    /// @return The element previously on top
+    constexpr T pop() {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop");
+        return this->unchecked_remove_at(0);
+    }
+
+    /**
+     * @brief Replace the greatest element with `val`: cheaper than `pop()` followed by `push()`
+     *
+     * Like `pop()`, the hole at the top is walked down to a leaf first and `val` then sifts up from there. A
+     * rescheduled timer or a replaced best order usually belongs near the bottom, so this saves the comparison
+     * against `val` at every level that a plain sift-down would make
+     * @return The element previously on top. Its handle now refers to `val`
+     */
+    constexpr T replace_top(T val) {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop");
+        const size_type h = this->handle_at(0);
+        T old = std::move(*this->slot(0));
+        const size_t hole = this->walk_hole_down(0, this->_current_size);
+        *this->slot(hole) = std::move(val);
+        this->place_handle(hole, h);
+        this->sift_up(hole);
+        return old;
+    }
+
+    /// @brief Get the element with handle `h`
+    [[nodiscard]] constexpr const T& get(handle_type h) const requires HANDLES {
+        return *this->slot(this->position_of(h, "Cannot access"));
+    }
+
+    /// @brief Change the element with handle `h` to `val`, moving it up or down as needed (decrease-key or
+    /// increase-key)
+    constexpr void update(handle_type h, T val) requires HANDLES {
+        const size_t pos = this->position_of(h, "Cannot update");
+        *this->slot(pos) = std::move(val);
+        this->restore(pos);
+    }
+
+    /// @brief Remove the element with handle `h`, wherever it is in the heap
+    /// @return The removed element
+    constexpr T erase(handle_type h) requires HANDLES {
+        return this->unchecked_remove_at(this->position_of(h, "Cannot erase"));
+    }
+};
+
+#endif //FIXED_PRIORITY_QUEUE_HPP
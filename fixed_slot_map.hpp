@@ -0,0 +1,312 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef FIXED_SLOT_MAP_HPP
+#define FIXED_SLOT_MAP_HPP
+
+#include "fixed_vector.hpp"
+
+#include <bit>
+
+/**
+ * @class fixed_slot_map
+ * @brief A table of at most `CAPACITY` values addressed by stable, generation-checked 32-bit handles, with no dynamic
+ * memory allocation
+ *
+ * Insertion and erasure are O(1). Values are kept densely packed, so iterating touches only live values; erasing moves
+ * the last value into the hole, so the order of iteration is not the order of insertion. A handle names a slot, and
+ * slots map to dense positions. Each slot has a generation that changes whenever its value is erased, so a handle to
+ * an erased value is detected instead of silently reaching whatever reused the slot
+ * @tparam T The value type
+ * @tparam CAPACITY The compile-time capacity of the map
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types
+ */
+template <typename T, size_t CAPACITY, typename Policy = fixed_vector_policy::default_policy>
+class fixed_slot_map {
+    static_assert(CAPACITY > 0, "Capacity cannot be 0");
+
+    /// @brief The low bits of a handle hold the slot index, the rest the generation
+    static constexpr unsigned INDEX_BITS = std::max(1u, static_cast<unsigned>(std::bit_width(CAPACITY - 1)));
+    static_assert(INDEX_BITS <= 24, "Capacity too large for 32-bit handles with at least 8 generation bits");
+    static constexpr std::uint32_t INDEX_MASK = (std::uint32_t{1} << INDEX_BITS) - 1;
+    static constexpr std::uint32_t GENERATION_MASK = ~std::uint32_t{0} >> INDEX_BITS;
+
+public:
+    /// @brief The type used to store the logical size: the smallest unsigned type that can hold `CAPACITY`
+    using size_type = fixed_vector_detail::smallest_size_t<CAPACITY>;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using difference_type = std::ptrdiff_t;
+    /// @brief Iterators are plain pointers over the dense values
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * @class handle
+     * @brief A 32-bit slot index and generation. A default-constructed handle never refers to a value
+     *
+     * Generations wrap around after `2^(32 - INDEX_BITS) - 1` erasures of the same slot, at which point a very old
+     * handle could become valid again
+     */
+    class handle {
+        friend class fixed_slot_map;
+
+        std::uint32_t _bits;
+
+        constexpr handle(std::uint32_t index, std::uint32_t generation) noexcept
+            : _bits(generation << INDEX_BITS | index)
+        {}
+
+    public:
+        constexpr handle() noexcept : _bits(0) {}
+
+        /// @brief Get the slot index
+        [[nodiscard]] constexpr std::uint32_t index() const noexcept { return this->_bits & INDEX_MASK; }
+
+        /// @brief Get the generation of the slot this handle was given out for
+        [[nodiscard]] constexpr std::uint32_t generation() const noexcept { return this->_bits >> INDEX_BITS; }
+
+        /// @brief Get the packed 32 bits, e.g. to use as an external id
+        [[nodiscard]] constexpr std::uint32_t raw() const noexcept { return this->_bits; }
+
+        /// @brief Rebuild a handle from the bits returned by `raw()`
+        [[nodiscard]] static constexpr handle from_raw(std::uint32_t bits) noexcept {
+            handle h;
+            h._bits = bits;
+            return h;
+        }
+
+        constexpr bool operator== (const handle&) const noexcept = default;
+    };
+
+private:
+    /// @brief The number of live values
+    size_type _current_size;
+    /// @brief The number of slots ever used. Slots at or past this are implicitly free with generation 1
+    size_type _slots_used;
+    /// @brief The first slot on the free list, or `CAPACITY` if it is empty
+    size_type _free_head;
+    /// @brief Uninitialized storage for the dense values. Only the first `_current_size` slots hold objects
+    fixed_vector_detail::storage<T, CAPACITY> _values;
+    /// @brief The slot of each dense value
+    fixed_vector_detail::storage<size_type, CAPACITY> _slot_of;
+    /// @brief For a live slot, the dense position of its value. For a free slot, the next free slot
+    fixed_vector_detail::storage<size_type, CAPACITY> _target;
+    /// @brief The current generation of each slot. Never 0, so that default handles are always stale
+    fixed_vector_detail::storage<std::uint32_t, CAPACITY> _generation;
+
+    constexpr T* slot(size_t pos) noexcept { return this->_values.data() + pos; }
+    constexpr const T* slot(size_t pos) const noexcept { return this->_values.data() + pos; }
+
+    /**
+     * @brief Get the dense position of the value of `h`, or `CAPACITY` if `h` is stale
+     *
+     * A free slot keeps its generation, so a handle rebuilt with `from_raw` can match it. The slot is only live if its
+     * target is a dense position that points back at it
+     */
+    constexpr size_t position_of(handle h) const noexcept {
+        const std::uint32_t s = h.index();
+        if (s >= this->_slots_used || this->_generation.data()[s] != h.generation()) return CAPACITY;
+        const size_t d = this->_target.data()[s];
+        if (d >= this->_current_size || this->_slot_of.data()[d] != s) return CAPACITY;
+        return d;
+    }
+
+    /// @brief Put slot `s` on the free list with a new generation, invalidating every handle to it
+    constexpr void release_slot(size_t s) noexcept {
+        std::uint32_t& gen = this->_generation.data()[s];
+        gen = (gen + 1) & GENERATION_MASK;
+        if (gen == 0) gen = 1;
+        this->_target.data()[s] = this->_free_head;
+        this->_free_head = static_cast<size_type>(s);
+    }
+
+    /// @brief Copy or move every value and slot of `m` into this empty map
+    template <bool MOVE, typename Other>
+    constexpr void construct_from(Other& m) {
+        if constexpr (MOVE) fixed_vector_detail::move_construct_n(m.slot(0), m._current_size, this->slot(0));
+        else fixed_vector_detail::copy_construct_n(m.slot(0), m._current_size, this->slot(0));
+        fixed_vector_detail::copy_construct_n(m._slot_of.data(), m._current_size, this->_slot_of.data());
+        fixed_vector_detail::copy_construct_n(m._target.data(), m._slots_used, this->_target.data());
+        fixed_vector_detail::copy_construct_n(m._generation.data(), m._slots_used, this->_generation.data());
+        this->_current_size = m._current_size;
+        this->_slots_used = m._slots_used;
+        this->_free_head = m._free_head;
+    }
+
+public:
+    /// @brief Default constructor. Initial size will be 0 and no slot is initialized
+    constexpr fixed_slot_map() : _current_size(0), _slots_used(0), _free_head(CAPACITY) {}
+
+    /// @brief Copy constructor. Handles to `m` are valid for the copy too
+    constexpr fixed_slot_map(const fixed_slot_map& m) requires std::is_copy_constructible_v<T>
+        : _current_size(0), _slots_used(0), _free_head(CAPACITY)
+    {
+        this->construct_from<false>(m);
+    }
+
+    /// @brief Move constructor. Handles to `m` are valid for the new map; the values of `m` are left moved-from
+    constexpr fixed_slot_map(fixed_slot_map&& m) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : _current_size(0), _slots_used(0), _free_head(CAPACITY)
+    {
+        this->construct_from<true>(m);
+    }
+
+    /// @brief Destructor for trivially destructible types: nothing to do
+    constexpr ~fixed_slot_map() requires std::is_trivially_destructible_v<T> = default;
+
+    /// @brief Destructor: destroys every live value
+    constexpr ~fixed_slot_map() { std::destroy(this->slot(0), this->slot(this->_current_size)); }
+
+    /// @brief Allow another map to be copied into this one using the `=` operator
+    constexpr fixed_slot_map& operator= (const fixed_slot_map& m) requires std::is_copy_constructible_v<T> {
+        if (this == &m) return *this;
+        std::destroy(this->slot(0), this->slot(this->_current_size));
+        this->construct_from<false>(m);
+        return *this;
+    }
+
+    /// @brief Allow another map to be moved into this one using the `=` operator
+    constexpr fixed_slot_map& operator= (fixed_slot_map&& m) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this == &m) return *this;
+        std::destroy(this->slot(0), this->slot(this->_current_size));
+        this->construct_from<true>(m);
+        return *this;
+    }
+
+    /// @brief Get the compile-time capacity of the map
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return CAPACITY; }
+
+    /// @brief Get the number of live values
+    [[nodiscard]] constexpr size_t size() const noexcept { return this->_current_size; }
+
+    /// @brief Whether the map holds no values
+    [[nodiscard]] constexpr bool empty() const noexcept { return this->_current_size == 0; }
+
+    /// @brief Erase every value, invalidating every outstanding handle
+    constexpr void clear() noexcept {
+        for (size_t d = 0; d < this->_current_size; ++d) this->release_slot(this->_slot_of.data()[d]);
+        std::destroy(this->slot(0), this->slot(this->_current_size));
+        this->_current_size = 0;
+    }
+
+    /// @brief Get a pointer to the dense values
+    [[nodiscard]] constexpr T* data() noexcept { return this->slot(0); }
+
+    /// @brief Get a const pointer to the dense values
+    [[nodiscard]] constexpr const T* data() const noexcept { return this->slot(0); }
+
+    /// @brief Construct a value in place
+    /// @return The handle of the new value
+    template <typename... Args>
+    constexpr handle emplace(Args&&... args) {
+        fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full,
+                                           "Cannot insert", CAPACITY);
+        const size_t d = this->_current_size;
+        // Construct first: if the constructor throws, no slot has been taken
+        std::construct_at(this->slot(d), std::forward<Args>(args)...);
+        size_t s;
+        if (this->_free_head != CAPACITY) {
+            s = this->_free_head;
+            this->_free_head = this->_target.data()[s];
+        } else {
+            s = this->_slots_used++;
+            this->_generation.data()[s] = 1;
+        }
+        this->_slot_of.data()[d] = static_cast<size_type>(s);
+        this->_target.data()[s] = static_cast<size_type>(d);
+        ++this->_current_size;
+        return handle(static_cast<std::uint32_t>(s), this->_generation.data()[s]);
+    }
+
+    /// @brief Copy a value into the map
+    /// @return The handle of the new value
+    constexpr handle insert(const T& val) { return this->emplace(val); }
+
+    /// @brief Move a value into the map
+    /// @return The handle of the new value
+    constexpr handle insert(T&& val) { return this->emplace(std::move(val)); }
+
+    /**
+     * @brief Erase the value of `h`, moving the last dense value into its place
+     * @return Whether `h` referred to a value. A stale handle is not an error
+     */
+    constexpr bool erase(handle h) {
+        const size_t d = this->position_of(h);
+        if (d == CAPACITY) return false;
+        const size_t last = this->_current_size - 1;
+        if (d != last) {
+            *this->slot(d) = std::move(*this->slot(last));
+            const size_type moved = this->_slot_of.data()[last];
+            this->_slot_of.data()[d] = moved;
+            this->_target.data()[moved] = static_cast<size_type>(d);
+        }
+        std::destroy_at(this->slot(last));
+        this->release_slot(h.index());
+        this->_current_size = static_cast<size_type>(last);
+        return true;
+    }
+
+    /// @brief Get a pointer to the value of `h`, or `nullptr` if `h` is stale
+    [[nodiscard]] constexpr T* find(handle h) noexcept {
+        const size_t d = this->position_of(h);
+        return d == CAPACITY ? nullptr : this->slot(d);
+    }
+
+    /// @brief Get a const pointer to the value of `h`, or `nullptr` if `h` is stale
+    [[nodiscard]] constexpr const T* find(handle h) const noexcept {
+        const size_t d = this->position_of(h);
+        return d == CAPACITY ? nullptr : this->slot(d);
+    }
+
+    /// @brief Whether `h` refers to a live value
+    [[nodiscard]] constexpr bool contains(handle h) const noexcept { return this->position_of(h) != CAPACITY; }
+
+    /// @brief Get the value of `h`, which must not be stale
+    T& operator[](handle h) {
+        const size_t d = this->position_of(h);
+        fixed_vector_detail::check<Policy>(d == CAPACITY, fixed_vector_error::out_of_range, "Cannot access",
+                                           h.index(), this->_slots_used);
+        return *this->slot(d);
+    }
+
+    /// @brief Get the value of `h`, which must not be stale
+    const T& operator[](handle h) const {
+        const size_t d = this->position_of(h);
+        fixed_vector_detail::check<Policy>(d == CAPACITY, fixed_vector_error::out_of_range, "Cannot access",
+                                           h.index(), this->_slots_used);
+        return *this->slot(d);
+    }
+
+    /// @brief Get the handle of the value at dense position `pos`, e.g. while iterating
+    [[nodiscard]] constexpr handle handle_at(size_t pos) const {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->_current_size);
+        const size_type s = this->_slot_of.data()[pos];
+        return handle(s, this->_generation.data()[s]);
+    }
+
+    /// @brief Get mutable iterator to the first dense value
+    constexpr iterator begin() { return this->slot(0); }
+
+    /// @brief Get mutable iterator past the last dense value
+    constexpr iterator end() { return this->slot(this->_current_size); }
+
+    /// @brief Get const iterator to the first dense value
+    constexpr const_iterator cbegin() const { return this->slot(0); }
+
+    /// @brief Get const iterator past the last dense value
+    constexpr const_iterator cend() const { return this->slot(this->_current_size); }
+
+    /// @brief Overload for getting const iterator to the first dense value
+    constexpr const_iterator begin() const { return cbegin(); }
+
+    /// @brief Overload for getting const iterator past the last dense value
+    constexpr const_iterator end() const { return cend(); }
+};
+
+#endif //FIXED_SLOT_MAP_HPP
@@ -0,0 +1,329 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef FIXED_SOA_VECTOR_HPP
+#define FIXED_SOA_VECTOR_HPP
+
+#include "fixed_vector.hpp"
+
+#include <span>
+#include <tuple>
+
+/**
+ * @class basic_fixed_soa_vector
+ * @brief A structure-of-arrays `fixed_vector`: one contiguous column per member type, no dynamic memory allocation
+ *
+ * Rows are pushed, popped and indexed like in `fixed_vector`, but each member lives in its own column, so a scan over
+ * one member only touches that member's memory. Row access returns a tuple of references, and every column is
+ * available as a `std::span` for SIMD scans
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types
+ * @tparam CAPACITY The compile-time capacity in rows
+ * @tparam Ts The column types
+ */
+template <typename Policy, size_t CAPACITY, typename... Ts>
+class basic_fixed_soa_vector {
+    static_assert(CAPACITY > 0, "Capacity cannot be 0");
+    static_assert(sizeof...(Ts) > 0, "A structure of arrays needs at least one column");
+
+public:
+    /// @brief The type used to store the logical size: the smallest unsigned type that can hold `CAPACITY`
+    using size_type = fixed_vector_detail::smallest_size_t<CAPACITY>;
+    /// @brief A row by value
+    using value_type = std::tuple<Ts...>;
+    /// @brief A proxy reference to a row: one reference per column
+    using reference = std::tuple<Ts&...>;
+    /// @brief A proxy const reference to a row: one const reference per column
+    using const_reference = std::tuple<const Ts&...>;
+    /// @brief The type of column `I`
+    template <size_t I>
+    using column_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+private:
+    /// @brief The current logical size in rows
+    size_type _current_size;
+    /// @brief Uninitialized storage for each column. Only the first `_current_size` slots of each hold objects
+    std::tuple<fixed_vector_detail::storage<Ts, CAPACITY>...> _columns;
+
+    /// @brief Call `f.template operator()<I>()` for every column index `I`
+    template <typename F>
+    constexpr void for_each_column(F&& f) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (f.template operator()<I>(), ...);
+        }(std::index_sequence_for<Ts...>{});
+    }
+
+    /**
+     * @brief Call `f.template operator()<I>()` for every column index `I`, where each call fills slots `[first, last)` of
+     * column `I`. If a call throws, the slots filled in the earlier columns are destroyed before rethrowing
+     */
+    template <typename F>
+    constexpr void construct_columns(size_t first, size_t last, F&& f) {
+#if FIXED_VECTOR_EXCEPTIONS
+        size_t built = 0;
+        try {
+            this->for_each_column([&]<size_t I>() {
+                f.template operator()<I>();
+                ++built;
+            });
+        } catch (...) {
+            this->for_each_column([&]<size_t I>() {
+                if (I < built) std::destroy(this->slot<I>(first), this->slot<I>(last));
+            });
+            throw;
+        }
+#else
+        (void)first;
+        (void)last;
+        this->for_each_column(f);
+#endif
+    }
+
+    /// @brief Get a pointer to slot `pos` of column `I`, which may or may not hold a live object
+    template <size_t I>
+    constexpr column_type<I>* slot(size_t pos) noexcept { return std::get<I>(this->_columns).data() + pos; }
+
+    /// @brief Get a const pointer to slot `pos` of column `I`, which may or may not hold a live object
+    template <size_t I>
+    constexpr const column_type<I>* slot(size_t pos) const noexcept {
+        return std::get<I>(this->_columns).data() + pos;
+    }
+
+    /// @brief Destroy the rows in `[first, _current_size)` and shrink the logical size to `first`
+    constexpr void destroy_from(size_type first) noexcept {
+        this->for_each_column([&]<size_t I>() {
+            std::destroy(this->slot<I>(first), this->slot<I>(this->_current_size));
+        });
+        this->_current_size = first;
+    }
+
+    /// @brief Move the row at `pos` out into a tuple
+    constexpr value_type take_row(size_t pos) {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return value_type(std::move(*this->slot<I>(pos))...);
+        }(std::index_sequence_for<Ts...>{});
+    }
+
+    /// @brief Copy or move every row of `v` into this empty vector
+    template <bool MOVE, typename Other>
+    constexpr void construct_from(Other& v) {
+        this->construct_columns(0, v._current_size, [&]<size_t I>() {
+            if constexpr (MOVE) fixed_vector_detail::move_construct_n(v.template slot<I>(0), v._current_size,
+                                                                      this->slot<I>(0));
+            else fixed_vector_detail::copy_construct_n(v.template slot<I>(0), v._current_size, this->slot<I>(0));
+        });
+        this->_current_size = v._current_size;
+    }
+
+public:
+    /// @brief Default constructor. Initial size will be 0 and no element is constructed
+    constexpr basic_fixed_soa_vector()
+        : _current_size(0)
+    {}
+
+    /// @brief Copy constructor
+    constexpr basic_fixed_soa_vector(const basic_fixed_soa_vector& v)
+        requires (std::is_copy_constructible_v<Ts> && ...)
+        : _current_size(0)
+    {
+        this->construct_from<false>(v);
+    }
+
+    /// @brief Move constructor. The rows of `v` are left in a moved-from state
+    constexpr basic_fixed_soa_vector(basic_fixed_soa_vector&& v)
+        noexcept((std::is_nothrow_move_constructible_v<Ts> && ...))
+        : _current_size(0)
+    {
+        this->construct_from<true>(v);
+    }
+
+    /// @brief Destructor for trivially destructible columns: nothing to do
+    constexpr ~basic_fixed_soa_vector() requires (std::is_trivially_destructible_v<Ts> && ...) = default;
+
+    /// @brief Destructor: destroys every live row
+    constexpr ~basic_fixed_soa_vector() { this->destroy_from(0); }
+
+    /// @brief Allow another vector to be copied into this one using the `=` operator
+    constexpr basic_fixed_soa_vector& operator= (const basic_fixed_soa_vector& v)
+        requires (std::is_copy_constructible_v<Ts> && ...)
+    {
+        if (this == &v) return *this;
+        this->destroy_from(0);
+        this->construct_from<false>(v);
+        return *this;
+    }
+
+    /// @brief Allow another vector to be moved into this one using the `=` operator
+    constexpr basic_fixed_soa_vector& operator= (basic_fixed_soa_vector&& v)
+        noexcept((std::is_nothrow_move_constructible_v<Ts> && ...))
+    {
+        if (this == &v) return *this;
+        this->destroy_from(0);
+        this->construct_from<true>(v);
+        return *this;
+    }
+
+    /// @brief Get the capacity in rows
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return CAPACITY; }
+
+    /// @brief Get the current logical size in rows
+    [[nodiscard]] constexpr size_t size() const { return this->_current_size; }
+
+    /// @brief Clear every row, destroying every live element
+    constexpr void clear() { this->destroy_from(0); }
+
+    /// @brief Get a pointer to the start of column `I`
+    template <size_t I>
+    [[nodiscard]] constexpr column_type<I>* data() { return this->slot<I>(0); }
+
+    /// @brief Get a const pointer to the start of column `I`
+    template <size_t I>
+    [[nodiscard]] constexpr const column_type<I>* data() const { return this->slot<I>(0); }
+
+    /// @brief Get the live part of column `I` as a contiguous span
+    template <size_t I>
+    [[nodiscard]] constexpr std::span<column_type<I>> column() { return {this->slot<I>(0), this->_current_size}; }
+
+    /// @brief Get the live part of column `I` as a contiguous const span
+    template <size_t I>
+    [[nodiscard]] constexpr std::span<const column_type<I>> column() const {
+        return {this->slot<I>(0), this->_current_size};
+    }
+
+    /// @brief Construct a row in place at the end, increasing the logical size by 1
+    /// @param vals One argument per column, forwarded to that column's constructor
+    template <typename... Us>
+    constexpr void emplace_back(Us&&... vals) {
+        static_assert(sizeof...(Us) == sizeof...(Ts), "Need exactly one value per column");
+        fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full,
+                                           "Cannot push back", CAPACITY);
+        const size_type size = this->_current_size;
+        auto args = std::forward_as_tuple(std::forward<Us>(vals)...);
+        this->construct_columns(size, size + 1, [&]<size_t I>() {
+            std::construct_at(this->slot<I>(size), std::get<I>(std::move(args)));
+        });
+        this->_current_size = static_cast<size_type>(size + 1);
+    }
+
+    /// @brief Copy a row to the end, increasing the logical size by 1
+    constexpr void push_back(const Ts&... vals) { this->emplace_back(vals...); }
+
+    /// @brief Copy a row to the end, increasing the logical size by 1
+    constexpr void push_back(const value_type& row) {
+        std::apply([&](const Ts&... vals) { this->emplace_back(vals...); }, row);
+    }
+
+    /// @brief Add a row to the front, increasing the logical size by 1
+    /// @warning Shifts every row to the right: could be costly for large vectors
+    constexpr void push_front(Ts... vals) {
+        fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full,
+                                           "Cannot push front", CAPACITY);
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (fixed_vector_detail::shift_right(this->slot<I>(0), this->_current_size, 0, 1), ...);
+            (std::construct_at(this->slot<I>(0), std::move(vals)), ...);
+        }(std::index_sequence_for<Ts...>{});
+        ++this->_current_size;
+    }
+
+    /// @brief Remove the last row, decreasing the logical size by 1
+    /// @return The row previously at the back
+    [[nodiscard]] constexpr value_type pop_back() {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop back");
+        value_type row = this->take_row(this->_current_size - 1);
+        this->destroy_from(this->_current_size - 1);
+        return row;
+    }
+
+    /// @brief Remove the first row, decreasing the logical size by 1
+    /// @return The row previously at the front
+    /// @warning Shifts every row to the left: could be costly for large vectors
+    [[nodiscard]] constexpr value_type pop_front() {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop front");
+        value_type row = this->take_row(0);
+        this->for_each_column([&]<size_t I>() {
+            fixed_vector_detail::shift_left(this->slot<I>(0), this->_current_size, 0, 1);
+        });
+        --this->_current_size;
+        return row;
+    }
+
+    /// @brief Access row `pos` through a tuple of references, e.g. `auto [price, qty] = ticks[i];`
+    constexpr reference operator[](size_t pos) {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->_current_size);
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return reference(*this->slot<I>(pos)...);
+        }(std::index_sequence_for<Ts...>{});
+    }
+
+    /// @brief Access row `pos` through a tuple of const references
+    constexpr const_reference operator[](size_t pos) const {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->_current_size);
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return const_reference(*this->slot<I>(pos)...);
+        }(std::index_sequence_for<Ts...>{});
+    }
+
+    /**
+     * @class basic_iterator
+     * @brief Iterates over rows, dereferencing to a tuple of references
+     *
+     * Dereferencing yields a proxy rather than a real reference, so this only models an input iterator for the
+     * classic algorithms; use `column<I>()` for algorithms over a single member
+     * @tparam CONST Whether the iterator gives const access
+     */
+    template <bool CONST>
+    class basic_iterator {
+        using vector_type = std::conditional_t<CONST, const basic_fixed_soa_vector, basic_fixed_soa_vector>;
+
+        vector_type* _vec;
+        size_t _pos;
+    public:
+        using value_type = basic_fixed_soa_vector::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<CONST, const_reference, basic_fixed_soa_vector::reference>;
+        using iterator_category = std::input_iterator_tag;
+
+        constexpr basic_iterator() : _vec(nullptr), _pos(0) {}
+        constexpr basic_iterator(vector_type* vec, size_t pos) : _vec(vec), _pos(pos) {}
+
+        constexpr reference operator*() const { return (*this->_vec)[this->_pos]; }
+
+        constexpr basic_iterator& operator++() { ++this->_pos; return *this; }
+        constexpr basic_iterator operator++(int) { basic_iterator tmp = *this; ++this->_pos; return tmp; }
+
+        friend constexpr bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) {
+            return lhs._pos == rhs._pos;
+        }
+    };
+
+    /// @brief Mutable row iterator type
+    using iterator = basic_iterator<false>;
+    /// @brief Const row iterator type
+    using const_iterator = basic_iterator<true>;
+
+    /// @brief Get mutable iterator to the first row
+    constexpr iterator begin() { return iterator(this, 0); }
+
+    /// @brief Get mutable iterator past the last row
+    constexpr iterator end() { return iterator(this, this->_current_size); }
+
+    /// @brief Get const iterator to the first row
+    constexpr const_iterator cbegin() const { return const_iterator(this, 0); }
+
+    /// @brief Get const iterator past the last row
+    constexpr const_iterator cend() const { return const_iterator(this, this->_current_size); }
+
+    /// @brief Overload for getting const iterator to the first row
+    constexpr const_iterator begin() const { return cbegin(); }
+
+    /// @brief Overload for getting const iterator past the last row
+    constexpr const_iterator end() const { return cend(); }
+};
+
+/// @brief A structure-of-arrays `fixed_vector` using the default error policy
+template <size_t CAPACITY, typename... Ts>
+using fixed_soa_vector = basic_fixed_soa_vector<fixed_vector_policy::default_policy, CAPACITY, Ts...>;
+
+#endif //FIXED_SOA_VECTOR_HPP
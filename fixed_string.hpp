@@ -0,0 +1,287 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef FIXED_STRING_HPP
+#define FIXED_STRING_HPP
+
+#include "fixed_vector.hpp"
+
+#include <bit>
+#include <compare>
+#include <functional>
+#include <string_view>
+
+namespace fixed_vector_detail {
+    /**
+     * @brief Get the index of the first byte that differs between `a` and `b` within `[0, n)`, or `n` if none does
+     * @warning Reads whole 16-byte blocks: both buffers must be 16-byte aligned and readable up to `n` rounded up to
+     * a multiple of 16. Bytes past `n` are read but never affect the result
+     */
+    constexpr size_t first_mismatch(const char* a, const char* b, size_t n) noexcept {
+#if FIXED_VECTOR_SSE2
+        if (!std::is_constant_evaluated()) {
+            for (size_t i = 0; i < n; i += 16) {
+                const __m128i va = _mm_load_si128(reinterpret_cast<const __m128i*>(a + i));
+                const __m128i vb = _mm_load_si128(reinterpret_cast<const __m128i*>(b + i));
+                unsigned diff = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) & 0xFFFFu;
+                if (n - i < 16) diff &= (1u << (n - i)) - 1;
+                if (diff != 0) return i + static_cast<size_t>(std::countr_zero(diff));
+            }
+            return n;
+        }
+#endif
+        for (size_t i = 0; i < n; ++i) {
+            if (a[i] != b[i]) return i;
+        }
+        return n;
+    }
+}
+
+/**
+ * @class fixed_string
+ * @brief A null-terminated string of at most `N` characters with no dynamic memory allocation
+ *
+ * Converts to and from `std::string_view`, so the usual searching and formatting code applies without going through
+ * `std::string`. The buffer is 16-byte aligned and padded to whole 16-byte blocks, which lets `==` and `<=>` compare
+ * a block at a time with SSE2 when available
+ * @tparam N The maximum number of characters, not counting the terminator
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types
+ */
+template <size_t N, typename Policy = fixed_vector_policy::default_policy>
+class fixed_string {
+    static_assert(N > 0, "Capacity cannot be 0");
+
+    template <size_t, typename>
+    friend class fixed_string;
+
+    /// @brief The number of `char` slots in the buffer: room for the terminator, rounded up to whole 16-byte blocks
+    static constexpr size_t BUFFER_SIZE = fixed_vector_detail::padded_capacity<char>(N + 1, 16);
+
+public:
+    /// @brief The type used to store the logical size: the smallest unsigned type that can hold `N`
+    using size_type = fixed_vector_detail::smallest_size_t<N>;
+    using value_type = char;
+    using reference = char&;
+    using const_reference = const char&;
+    using pointer = char*;
+    using const_pointer = const char*;
+    using difference_type = std::ptrdiff_t;
+    using iterator = char*;
+    using const_iterator = const char*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /// @brief Returned by the `find` functions when nothing matches
+    static constexpr size_t npos = std::string_view::npos;
+
+private:
+    /// @brief The current length, not counting the terminator
+    size_type _current_size;
+    /// @brief The characters, always followed by a `'\0'` at `_current_size`
+    fixed_vector_detail::storage<char, BUFFER_SIZE, 16> _buf;
+
+    /// @brief Set the length to `size` and write the terminator after it
+    constexpr void set_size(size_t size) noexcept {
+        this->_current_size = static_cast<size_type>(size);
+        this->_buf.data()[size] = '\0';
+    }
+
+public:
+    /// @brief Default constructor: an empty string
+    constexpr fixed_string() : _current_size(0) { this->_buf.data()[0] = '\0'; }
+
+    /// @brief Construct from the characters of `sv`, which must fit in `N`
+    constexpr fixed_string(std::string_view sv) : _current_size(0) {
+        fixed_vector_detail::check<Policy>(sv.size() > N, fixed_vector_error::too_many, "Cannot construct",
+                                           sv.size(), N);
+        std::char_traits<char>::copy(this->_buf.data(), sv.data(), sv.size());
+        this->set_size(sv.size());
+    }
+
+    /// @brief Construct from a null-terminated string, which must fit in `N`
+    constexpr fixed_string(const char* str) : fixed_string(std::string_view(str)) {}
+
+    /// @brief Get the maximum length
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+
+    /// @brief Get the current length
+    [[nodiscard]] constexpr size_t size() const noexcept { return this->_current_size; }
+
+    /// @brief Get the current length
+    [[nodiscard]] constexpr size_t length() const noexcept { return this->_current_size; }
+
+    /// @brief Whether the string has no characters
+    [[nodiscard]] constexpr bool empty() const noexcept { return this->_current_size == 0; }
+
+    /// @brief Clear the string contents
+    constexpr void clear() noexcept { this->set_size(0); }
+
+    /// @brief Get a pointer to the characters
+    /// @warning Writing a `'\0'` through it does not change `size()`
+    [[nodiscard]] constexpr char* data() noexcept { return this->_buf.data(); }
+
+    /// @brief Get a const pointer to the null-terminated characters
+    [[nodiscard]] constexpr const char* data() const noexcept { return this->_buf.data(); }
+
+    /// @brief Get a const pointer to the null-terminated characters
+    [[nodiscard]] constexpr const char* c_str() const noexcept { return this->_buf.data(); }
+
+    /// @brief Get a view of the characters
+    [[nodiscard]] constexpr std::string_view view() const noexcept {
+        return std::string_view(this->_buf.data(), this->_current_size);
+    }
+
+    /// @brief Allow implicit conversion to `std::string_view`
+    constexpr operator std::string_view() const noexcept { return this->view(); }
+
+    /// @brief Add a character to the end, increasing the length by 1
+    constexpr void push_back(char c) {
+        fixed_vector_detail::check<Policy>(this->_current_size == N, fixed_vector_error::full,
+                                           "Cannot push back", N);
+        this->_buf.data()[this->_current_size] = c;
+        this->set_size(this->_current_size + 1);
+    }
+
+    /// @brief Remove a character from the end, decreasing the length by 1
+    /// @return The character previously at the back
+    constexpr char pop_back() {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop back");
+        const char c = this->_buf.data()[this->_current_size - 1];
+        this->set_size(this->_current_size - 1);
+        return c;
+    }
+
+    /// @brief Add the characters of `sv` to the end. Fails without changing anything if they do not all fit
+    constexpr fixed_string& append(std::string_view sv) {
+        fixed_vector_detail::check<Policy>(sv.size() > N - this->_current_size, fixed_vector_error::too_many,
+                                           "Cannot append", this->_current_size + sv.size(), N);
+        // `move` rather than `copy`: `sv` may view this very string
+        std::char_traits<char>::move(this->_buf.data() + this->_current_size, sv.data(), sv.size());
+        this->set_size(this->_current_size + sv.size());
+        return *this;
+    }
+
+    /// @brief Add the characters of `sv` to the end
+    constexpr fixed_string& operator+= (std::string_view sv) { return this->append(sv); }
+
+    /// @brief Add a character to the end
+    constexpr fixed_string& operator+= (char c) {
+        this->push_back(c);
+        return *this;
+    }
+
+    /// @brief Get the index of the first occurrence of `sv` at or after `pos`, or `npos`
+    [[nodiscard]] constexpr size_t find(std::string_view sv, size_t pos = 0) const noexcept {
+        return this->view().find(sv, pos);
+    }
+
+    /// @brief Get the index of the first occurrence of `c` at or after `pos`, or `npos`
+    [[nodiscard]] constexpr size_t find(char c, size_t pos = 0) const noexcept { return this->view().find(c, pos); }
+
+    /// @brief Whether the string begins with `sv`
+    [[nodiscard]] constexpr bool starts_with(std::string_view sv) const noexcept {
+        return this->view().starts_with(sv);
+    }
+
+    /// @brief Whether the string begins with `c`
+    [[nodiscard]] constexpr bool starts_with(char c) const noexcept { return this->view().starts_with(c); }
+
+    /// @brief Whether the string ends with `sv`
+    [[nodiscard]] constexpr bool ends_with(std::string_view sv) const noexcept { return this->view().ends_with(sv); }
+
+    /// @brief Whether the string ends with `c`
+    [[nodiscard]] constexpr bool ends_with(char c) const noexcept { return this->view().ends_with(c); }
+
+    /// @brief Allow square-bracket indexing like a `std::string`
+    constexpr char& operator[](size_t pos) {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->_current_size);
+        return this->_buf.data()[pos];
+    }
+
+    /// @brief Allow const square-bracket indexing like a `std::string`
+    constexpr const char& operator[](size_t pos) const {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->_current_size);
+        return this->_buf.data()[pos];
+    }
+
+    /// @brief Compare with another `fixed_string` a 16-byte block at a time
+    template <size_t M, typename P>
+    constexpr bool operator== (const fixed_string<M, P>& s) const noexcept {
+        return this->_current_size == s._current_size &&
+               fixed_vector_detail::first_mismatch(this->_buf.data(), s._buf.data(), this->_current_size) ==
+               this->_current_size;
+    }
+
+    /// @brief Order lexicographically against another `fixed_string`, a 16-byte block at a time
+    template <size_t M, typename P>
+    constexpr std::strong_ordering operator<=> (const fixed_string<M, P>& s) const noexcept {
+        const size_t n = std::min<size_t>(this->_current_size, s._current_size);
+        const size_t i = fixed_vector_detail::first_mismatch(this->_buf.data(), s._buf.data(), n);
+        if (i != n) {
+            // Characters compare as `unsigned char`, like `std::char_traits<char>`
+            return static_cast<unsigned char>(this->_buf.data()[i]) <=> static_cast<unsigned char>(s._buf.data()[i]);
+        }
+        return this->size() <=> s.size();
+    }
+
+    /// @brief Compare with any string view
+    constexpr bool operator== (std::string_view sv) const noexcept { return this->view() == sv; }
+
+    /// @brief Order lexicographically against any string view
+    constexpr std::strong_ordering operator<=> (std::string_view sv) const noexcept { return this->view() <=> sv; }
+
+    /// @brief Compare with a null-terminated string
+    constexpr bool operator== (const char* str) const noexcept { return this->view() == std::string_view(str); }
+
+    /// @brief Order lexicographically against a null-terminated string
+    constexpr std::strong_ordering operator<=> (const char* str) const noexcept {
+        return this->view() <=> std::string_view(str);
+    }
+
+    /// @brief Get mutable iterator to beginning
+    constexpr iterator begin() { return this->_buf.data(); }
+
+    /// @brief Get mutable iterator to end
+    constexpr iterator end() { return this->_buf.data() + this->_current_size; }
+
+    /// @brief Get const iterator to beginning
+    constexpr const_iterator cbegin() const { return this->_buf.data(); }
+
+    /// @brief Get const iterator to end
+    constexpr const_iterator cend() const { return this->_buf.data() + this->_current_size; }
+
+    /// @brief Overload for getting const iterator to beginning
+    constexpr const_iterator begin() const { return cbegin(); }
+
+    /// @brief Overload for getting const iterator to end
+    constexpr const_iterator end() const { return cend(); }
+
+    /// @brief Get mutable reverse iterator to the last character
+    constexpr reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+
+    /// @brief Get mutable reverse iterator to before the first character
+    constexpr reverse_iterator rend() { return reverse_iterator(this->begin()); }
+
+    /// @brief Get const reverse iterator to the last character
+    constexpr const_reverse_iterator crbegin() const { return const_reverse_iterator(this->cend()); }
+
+    /// @brief Get const reverse iterator to before the first character
+    constexpr const_reverse_iterator crend() const { return const_reverse_iterator(this->cbegin()); }
+
+    /// @brief Overload for getting const reverse iterator to the last character
+    constexpr const_reverse_iterator rbegin() const { return crbegin(); }
+
+    /// @brief Overload for getting const reverse iterator to before the first character
+    constexpr const_reverse_iterator rend() const { return crend(); }
+};
+
+/// @brief Hash a `fixed_string` like the equivalent `std::string_view`, so either can be used to look it up
+template <size_t N, typename Policy>
+struct std::hash<fixed_string<N, Policy>> {
+    size_t operator()(const fixed_string<N, Policy>& s) const noexcept { return std::hash<std::string_view>{}(s); }
+};
+
+#endif //FIXED_STRING_HPP
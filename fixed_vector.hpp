@@ -5,14 +5,430 @@
 #ifndef FIXED_VECTOR_HPP
 #define FIXED_VECTOR_HPP
 
+#include <algorithm>
 #include <array>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <cstddef>
-#ifndef FIXED_VECTOR_NOEXCEPT
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+
+/*
+ * Errors are reported with exceptions only if the compiler has them enabled and `FIXED_VECTOR_NOEXCEPT` is not defined.
+ * Otherwise the throwing policy is unavailable and the default policy traps instead
+ */
+#if !defined(FIXED_VECTOR_NOEXCEPT) && (defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
+#define FIXED_VECTOR_EXCEPTIONS 1
+#else
+#define FIXED_VECTOR_EXCEPTIONS 0
 #endif
 
+/*
+ * SSE2 fast paths are compiled in whenever the target has SSE2, which every x86-64 target does. Everything else uses
+ * the portable scalar code
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FIXED_VECTOR_SSE2 1
+#else
+#define FIXED_VECTOR_SSE2 0
+#endif
+
+/// @brief The kinds of error a fixed-capacity container can detect, passed to its error policy
+enum class fixed_vector_error {
+    /// @brief An insertion into a container that is already at capacity. Details: capacity
+    full,
+    /// @brief A removal from an empty container. Details: none
+    empty,
+    /// @brief An index past the logical end. Details: index, current size
+    out_of_range,
+    /// @brief A request for more elements than the capacity allows. Details: requested count, capacity
+    too_many,
+};
+
+namespace fixed_vector_detail {
+    /*
+     * Error paths are kept out of line and marked cold so that an inlined check compiles down to a compare and a
+     * never-taken branch, with all message formatting living in one shared copy of each function
+     */
+
+    /// @brief Write a human-readable description of an error into `msg`
+    /// @param what What was attempted, e.g. "Cannot push back"
+    /// @param a, b The error details, see `fixed_vector_error`
+    inline void describe_error(char (&msg)[128], fixed_vector_error err, const char* what, size_t a, size_t b) {
+        switch (err) {
+            case fixed_vector_error::full:
+                std::snprintf(msg, sizeof(msg), "%s: container is at capacity %zu", what, a);
+                break;
+            case fixed_vector_error::empty:
+                std::snprintf(msg, sizeof(msg), "%s: container is empty", what);
+                break;
+            case fixed_vector_error::out_of_range:
+                std::snprintf(msg, sizeof(msg), "%s: index %zu is out of range for current size %zu", what, a, b);
+                break;
+            case fixed_vector_error::too_many:
+                std::snprintf(msg, sizeof(msg), "%s: %zu elements do not fit in capacity %zu", what, a, b);
+                break;
+        }
+    }
+
+#if FIXED_VECTOR_EXCEPTIONS
+    /// @brief Throw `std::out_of_range` for index errors and `std::length_error` for everything else
+    [[noreturn, gnu::cold, gnu::noinline]] inline void throw_error(fixed_vector_error err, const char* what,
+                                                                   size_t a, size_t b) {
+        char msg[128];
+        describe_error(msg, err, what, a, b);
+        if (err == fixed_vector_error::out_of_range) throw std::out_of_range(msg);
+        throw std::length_error(msg);
+    }
+#endif
+
+    /// @brief Print a description of the error to `stderr` and abort, like a failed `assert`
+    [[noreturn, gnu::cold, gnu::noinline]] inline void abort_error(fixed_vector_error err, const char* what,
+                                                                   size_t a, size_t b) {
+        char msg[128];
+        describe_error(msg, err, what, a, b);
+        std::fprintf(stderr, "fixed_vector: %s\n", msg);
+        std::abort();
+    }
+}
+
+/**
+ * @brief Error policies selecting what a container does when a check fails
+ *
+ * A policy provides `static constexpr bool CHECKED`, telling the container whether to perform its checks at all, and
+ * `[[noreturn]] static void fail(fixed_vector_error err, const char* what, size_t a, size_t b)`, called on failure.
+ * The policy is part of the container type, so differently-checked containers can be mixed freely in one program
+ */
+namespace fixed_vector_policy {
+#if FIXED_VECTOR_EXCEPTIONS
+    /// @brief Throw `std::out_of_range` for bad indices and `std::length_error` for size errors
+    struct throw_on_error {
+        static constexpr bool CHECKED = true;
+        [[noreturn]] static void fail(fixed_vector_error err, const char* what, size_t a, size_t b) {
+            fixed_vector_detail::throw_error(err, what, a, b);
+        }
+    };
+#endif
+
+    /// @brief Print the error and abort like `assert` does. Checks compile away entirely when `NDEBUG` is defined
+    struct assert_on_error {
+#ifdef NDEBUG
+        static constexpr bool CHECKED = false;
+#else
+        static constexpr bool CHECKED = true;
+#endif
+        [[noreturn]] static void fail(fixed_vector_error err, const char* what, size_t a, size_t b) {
+            fixed_vector_detail::abort_error(err, what, a, b);
+        }
+    };
+
+    /// @brief Execute a trap instruction: the cheapest check that still stops the program
+    struct trap_on_error {
+        static constexpr bool CHECKED = true;
+        [[noreturn]] static void fail(fixed_vector_error, const char*, size_t, size_t) {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_trap();
+#else
+            std::abort();
+#endif
+        }
+    };
+
+    /**
+     * @brief Call a user-provided handler. The handler may throw, but if it returns the program is aborted
+     * @tparam HANDLER Called with the error kind, a description of the attempt and the error details
+     */
+    template <void (*HANDLER)(fixed_vector_error err, const char* what, size_t a, size_t b)>
+    struct callback {
+        static constexpr bool CHECKED = true;
+        [[noreturn, gnu::cold, gnu::noinline]] static void fail(fixed_vector_error err, const char* what,
+                                                               size_t a, size_t b) {
+            HANDLER(err, what, a, b);
+            std::abort();
+        }
+    };
+
+    /// @brief Perform no checks at all. Violating a precondition is undefined behaviour
+    struct unchecked {
+        static constexpr bool CHECKED = false;
+        [[noreturn]] static void fail(fixed_vector_error, const char*, size_t, size_t) { std::abort(); }
+    };
+
+    /// @brief The policy used when none is given: throwing, or trapping if exceptions are unavailable
+#if FIXED_VECTOR_EXCEPTIONS
+    using default_policy = throw_on_error;
+#else
+    using default_policy = trap_on_error;
+#endif
+}
+
+namespace fixed_vector_detail {
+    /// @brief Report `err` through `Policy` if `failed` is true and the policy performs checks
+    template <typename Policy>
+    constexpr void check(bool failed, fixed_vector_error err, const char* what, size_t a = 0, size_t b = 0) {
+        if constexpr (Policy::CHECKED) {
+            if (failed) [[unlikely]] Policy::fail(err, what, a, b);
+        }
+    }
+
+    /// @brief The smallest unsigned integer type able to count from 0 up to and including `N`
+    template <size_t N>
+    using smallest_size_t =
+        std::conditional_t<N <= UINT8_MAX, std::uint8_t,
+        std::conditional_t<N <= UINT16_MAX, std::uint16_t,
+        std::conditional_t<N <= UINT32_MAX, std::uint32_t,
+        std::uint64_t>>>;
+
+    /**
+     * @brief The number of `T` slots needed for `CAPACITY` elements when the buffer is rounded up to whole
+     * `ALIGNMENT`-byte blocks, so that a full-width vector load at the last element never leaves the buffer
+     *
+     * When `sizeof(T)` does not divide `ALIGNMENT`, the last slot straddles the end of the last block, so the slot
+     * count is rounded up too
+     */
+    template <typename T>
+    constexpr size_t padded_capacity(size_t capacity, size_t alignment) {
+        const size_t bytes = (capacity * sizeof(T) + alignment - 1) / alignment * alignment;
+        return (bytes + sizeof(T) - 1) / sizeof(T);
+    }
+
+    /**
+     * @brief Uninitialized storage for `CAPACITY` objects of type `T`, aligned to `ALIGNMENT` bytes
+     *
+     * Raw aligned bytes that objects are constructed into explicitly. Such storage cannot be used during constant
+     * evaluation, so types that are trivial to create and destroy get the specialization below instead
+     */
+    template <typename T, size_t CAPACITY, size_t ALIGNMENT = alignof(T),
+              bool TRIVIAL = std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>>
+    struct storage {
+        alignas(ALIGNMENT) std::byte _bytes[sizeof(T) * CAPACITY];
+
+        T* data() noexcept { return std::launder(reinterpret_cast<T*>(this->_bytes)); }
+        const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(this->_bytes)); }
+    };
+
+    /**
+     * @brief Storage for types that are trivial to create and destroy: a plain array, usable in constant expressions
+     *
+     * At run time the array is left uninitialized just like the raw bytes. During constant evaluation every element
+     * has to hold a value, so the array is value-initialized there instead
+     */
+    template <typename T, size_t CAPACITY, size_t ALIGNMENT>
+    struct storage<T, CAPACITY, ALIGNMENT, true> {
+        alignas(ALIGNMENT) T _elems[CAPACITY];
+
+        constexpr storage() noexcept {
+            if (std::is_constant_evaluated())
+                for (T& elem : this->_elems) std::construct_at(&elem);
+        }
+
+        constexpr T* data() noexcept { return this->_elems; }
+        constexpr const T* data() const noexcept { return this->_elems; }
+    };
+
+    /**
+     * @brief Construct `dst[i]` from `make(i)` for every `i` in `[0, n)`
+     *
+     * If a constructor throws, the objects already constructed are destroyed before the exception propagates, so
+     * `dst` is left as raw storage
+     */
+    template <typename T, typename F>
+    constexpr void construct_n(T* dst, size_t n, F make) {
+#if FIXED_VECTOR_EXCEPTIONS
+        size_t i = 0;
+        try {
+            for (; i < n; ++i) std::construct_at(dst + i, make(i));
+        } catch (...) {
+            std::destroy(dst, dst + i);
+            throw;
+        }
+#else
+        for (size_t i = 0; i < n; ++i) std::construct_at(dst + i, make(i));
+#endif
+    }
+
+    /**
+     * @brief Copy-construct `n` objects from `src` into the raw storage at `dst`
+     *
+     * Trivially copyable types are copied with a single `memcpy` outside of constant evaluation.
+     * If a copy throws, the copies already made are destroyed
+     */
+    template <typename T>
+    constexpr void copy_construct_n(const T* src, size_t n, T* dst) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                if (n != 0) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+                return;
+            }
+        }
+        construct_n(dst, n, [src](size_t i) -> const T& { return src[i]; });
+    }
+
+    /**
+     * @brief Move-construct `n` objects from `src` into the raw storage at `dst`
+     *
+     * Trivially copyable types are copied with a single `memcpy` outside of constant evaluation.
+     * The sources are left in a moved-from state. If a move throws, the objects already moved to are destroyed
+     */
+    template <typename T>
+    constexpr void move_construct_n(T* src, size_t n, T* dst) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                if (n != 0) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+                return;
+            }
+        }
+        construct_n(dst, n, [src](size_t i) -> T&& { return std::move(src[i]); });
+    }
+
+    /// @brief Whether `[first, first + n)` can be copy-constructed into `T` storage with a single `memcpy`
+    template <typename It, typename T>
+    inline constexpr bool memcpy_range_v = std::contiguous_iterator<It> && std::is_trivially_copyable_v<T> &&
+                                           std::is_same_v<std::remove_cv_t<std::iter_value_t<It>>, T>;
+
+    /**
+     * @brief Move the live objects `[pos, size)` of `data` to `[pos + count, size + count)`
+     *
+     * Afterwards `[pos, pos + count)` is raw storage that the caller must construct into.
+     * Trivially copyable types are shifted with a single `memmove` outside of constant evaluation
+     * @warning DOES NOT BOUNDS CHECK: `size + count` must not exceed the storage capacity
+     */
+    template <typename T>
+    constexpr void shift_right(T* data, size_t size, size_t pos, size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                if (size != pos)
+                    std::memmove(static_cast<void*>(data + pos + count), static_cast<const void*>(data + pos),
+                                 (size - pos) * sizeof(T));
+                return;
+            }
+        }
+        // Walk backwards so no source is overwritten before it has been moved
+        for (size_t i = size; i > pos; --i) {
+            T* src = data + i - 1;
+            T* dst = src + count;
+            if (i - 1 + count >= size) std::construct_at(dst, std::move(*src));
+            else *dst = std::move(*src);
+        }
+        std::destroy(data + pos, data + std::min(pos + count, size));
+    }
+
+    /**
+     * @brief Destroy the live objects `[pos, pos + count)` of `data` and move `[pos + count, size)` down over them
+     *
+     * Afterwards only `[0, size - count)` holds live objects.
+     * Trivially copyable types are shifted with a single `memmove` outside of constant evaluation
+     * @warning DOES NOT BOUNDS CHECK: `pos + count` must not exceed `size`
+     */
+    template <typename T>
+    constexpr void shift_left(T* data, size_t size, size_t pos, size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                if (size != pos + count)
+                    std::memmove(static_cast<void*>(data + pos), static_cast<const void*>(data + pos + count),
+                                 (size - pos - count) * sizeof(T));
+                return;
+            }
+        }
+        std::move(data + pos + count, data + size, data + pos);
+        std::destroy(data + size - count, data + size);
+    }
+}
+
+/**
+ * @class fixed_vector_base
+ * @brief The operations of `fixed_vector<T, CAPACITY>` that do not depend on its capacity
+ *
+ * Inserting and erasing in the middle, assignment, swapping, comparison and destruction are compiled once per element
+ * type here and kept out of line, so a program using one element type at many capacities carries a single copy of
+ * each instead of one per capacity. Pushing, popping at the back and indexing stay inline in the vector.
+ *
+ * Holds no data: the vector keeps its inline storage and narrow size, and passes them in as a pointer and a count
+ */
+template <typename T>
+class fixed_vector_base {
+protected:
+    /// @brief Destroy the live objects `[0, n)` of `data`
+    [[gnu::noinline]] static constexpr void destroy_n(T* data, size_t n) noexcept { std::destroy(data, data + n); }
+
+    /// @brief Shift the live objects `[pos, size)` of `data` right by `count`, leaving a gap of raw slots at `pos`
+    /// @warning DOES NOT BOUNDS CHECK: `size + count` must not exceed the capacity and `pos` must not exceed `size`
+    [[gnu::noinline]] static constexpr void open_gap(T* data, size_t size, size_t pos, size_t count) {
+        fixed_vector_detail::shift_right(data, size, pos, count);
+    }
+
+    /// @brief Move `val` into `data` at `pos`, shifting the live objects `[pos, size)` to the right
+    /// @warning DOES NOT BOUNDS CHECK: `size` must be less than the capacity and `pos` must not exceed `size`
+    [[gnu::noinline]] static constexpr T& insert_at(T* data, size_t size, size_t pos, T&& val) {
+        fixed_vector_detail::shift_right(data, size, pos, 1);
+        return *std::construct_at(data + pos, std::move(val));
+    }
+
+    /// @brief Destroy the live objects `[pos, pos + count)` of `data`, shifting the ones after them to the left
+    /// @warning DOES NOT BOUNDS CHECK: `pos + count` must not exceed `size`
+    [[gnu::noinline]] static constexpr void erase_at(T* data, size_t size, size_t pos, size_t count) {
+        fixed_vector_detail::shift_left(data, size, pos, count);
+    }
+
+    /**
+     * @brief Make the `size` live objects of `data` a copy, or with `MOVE` a move, of the `n` objects of `src`
+     *
+     * Objects both ranges hold are assigned, extra objects of `src` are constructed and surplus objects of `data` are
+     * destroyed
+     * @warning DOES NOT BOUNDS CHECK: `n` must not exceed the capacity of `data`
+     */
+    template <bool MOVE>
+    [[gnu::noinline]] static constexpr void assign(T* data, size_t size, std::conditional_t<MOVE, T*, const T*> src,
+                                                   size_t n) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            fixed_vector_detail::copy_construct_n<T>(src, n, data);
+        } else if (n <= size) {
+            if constexpr (MOVE) std::move(src, src + n, data);
+            else std::copy_n(src, n, data);
+            std::destroy(data + n, data + size);
+        } else {
+            if constexpr (MOVE) {
+                std::move(src, src + size, data);
+                fixed_vector_detail::move_construct_n(src + size, n - size, data + size);
+            } else {
+                std::copy_n(src, size, data);
+                fixed_vector_detail::copy_construct_n(src + size, n - size, data + size);
+            }
+        }
+    }
+
+    /**
+     * @brief Exchange the `a_size` live objects of `a` with the `b_size` live objects of `b`
+     *
+     * The common prefix is swapped element-wise and the longer range's remaining objects are moved across and
+     * destroyed at their source. The caller swaps the sizes
+     */
+    [[gnu::noinline]] static constexpr void swap_ranges(T* a, size_t a_size, T* b, size_t b_size) {
+        if (a_size > b_size) {
+            std::swap(a, b);
+            std::swap(a_size, b_size);
+        }
+        std::swap_ranges(a, a + a_size, b);
+        fixed_vector_detail::move_construct_n(b + a_size, b_size - a_size, a + a_size);
+        std::destroy(b + a_size, b + b_size);
+    }
+
+    /// @brief Whether the first `n` objects of `a` and `b` compare equal
+    [[gnu::noinline]] static constexpr bool equal(const T* a, const T* b, size_t n) {
+        return std::equal(a, a + n, b);
+    }
+};
+
 /**
  * @class fixed_vector
  * @brief Allows functionality like `std::vector<T>` but with no dynamic memory allocation
@@ -20,441 +436,650 @@
  * Has fixed compile-time storage like `std::array<T, CAPACITY>` but may logically contain less than `CAPACITY` items
  * @tparam T The data type to store in the fixed vector
  * @tparam CAPACITY The compile-time capacity of the fixed vector
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types
+ * @tparam ALIGNMENT The alignment of the element storage in bytes, e.g. 32 or 64 for SIMD kernels. When larger than
+ * `alignof(T)`, the storage is also padded to a whole number of `ALIGNMENT`-byte blocks, see `padded_capacity()`
  */
-template <typename T, size_t CAPACITY>
-class fixed_vector {
+template <typename T, size_t CAPACITY, typename Policy = fixed_vector_policy::default_policy,
+          size_t ALIGNMENT = alignof(T)>
+class fixed_vector : private fixed_vector_base<T> {
+    using base = fixed_vector_base<T>;
+
     static_assert(CAPACITY > 0, "Capacity cannot be 0");
+    static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "Alignment must be a power of two");
+    static_assert(ALIGNMENT >= alignof(T), "Alignment cannot be less than the alignment of T");
+
+    /// @brief The number of slots actually allocated: `CAPACITY` rounded up to whole `ALIGNMENT`-byte blocks
+    static constexpr size_t PADDED_CAPACITY = fixed_vector_detail::padded_capacity<T>(CAPACITY, ALIGNMENT);
+
+    /// @brief Whether bytes written straight into the storage, e.g. by `read()`, form valid elements
+    static constexpr bool OVERWRITABLE = std::is_trivially_copyable_v<T> && std::is_trivially_default_constructible_v<T>;
+
+public:
+    /// @brief The type used to store the logical size: the smallest unsigned type that can hold `CAPACITY`
+    using size_type = fixed_vector_detail::smallest_size_t<CAPACITY>;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using difference_type = std::ptrdiff_t;
+    /**
+     * @brief Mutable iterator type
+     *
+     * Plain pointers: the elements are contiguous, and standard algorithms such as `std::copy`, `std::fill` and
+     * `std::equal` only select their `memmove`/`memcmp`/vectorized implementations for pointer ranges
+     */
+    using iterator = T*;
+    /// @brief Const iterator type
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-    /// @brief The logical capacity and actual size of the fixed vector
-    const size_t _capacity;
+private:
     /// @brief The current logical size of the fixed vector
-    size_t _current_size;
-    /// @brief The underlying `std::array<T, CAPACITY>` that does the actual storage
-    std::array<T, CAPACITY> _buf;
+    size_type _current_size;
+    /**
+     * @brief Uninitialized storage for the elements
+     *
+     * Only the first `_current_size` slots contain live objects. Elements are constructed and destroyed explicitly,
+     * so constructing an empty `fixed_vector` never touches the buffer
+     */
+    fixed_vector_detail::storage<T, PADDED_CAPACITY, ALIGNMENT> _buf;
+
+    /// @brief The capacity-erased view reads and writes `_current_size` directly
+    template <typename, typename> friend class fixed_vector_ref;
+
+    /// @brief Get a pointer to the storage slot at `pos`, which may or may not hold a live object
+    constexpr T* slot(size_t pos) noexcept { return this->_buf.data() + pos; }
+
+    /// @brief Get a const pointer to the storage slot at `pos`, which may or may not hold a live object
+    constexpr const T* slot(size_t pos) const noexcept { return this->_buf.data() + pos; }
+
+    /// @brief Destroy the live objects in `[first, _current_size)` and shrink the logical size to `first`
+    constexpr void destroy_from(size_type first) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            if (first != this->_current_size) base::destroy_n(this->slot(first), this->_current_size - first);
+        }
+        this->_current_size = first;
+    }
 
     /**
-     * @fn unsafe_right_shift_by_one
-     * @brief Blindly shift everything to the right by 1
+     * @fn unsafe_right_shift
+     * @brief Blindly open a gap of `count` raw slots at `pos`, shifting everything after it to the right
      *
+     * The logical size grows by `count`; the caller must construct an object into every slot of the gap.
      * Should only be called after bounds checking has been done
      * @warning DOES NOT BOUNDS CHECK
      */
-    void unsafe_right_shift_by_one() {
-        ++this->_current_size;
-        for (size_t i = this->_current_size; i > 0; --i) this->_buf[i] = this->_buf[i-1];
+    constexpr void unsafe_right_shift(size_t pos, size_t count) {
+        base::open_gap(this->slot(0), this->_current_size, pos, count);
+        this->_current_size = static_cast<size_type>(this->_current_size + count);
     }
 
     /**
-     * @fn unsafe_left_shift_by_one
-     * @brief Blindly shift everything to the left by 1
+     * @fn unsafe_left_shift
+     * @brief Blindly destroy `count` elements at `pos`, shifting everything after them to the left
      *
      * Should only be called after bounds checking has been done
      * @warning DOES NOT BOUNDS CHECK
      */
-    void unsafe_left_shift_by_one() {
-        for (size_t i = 1; i < this->_current_size; ++i) this->_buf[i-1] = this->_buf[i];
-        --this->_current_size;
+    constexpr void unsafe_left_shift(size_t pos, size_t count) {
+        base::erase_at(this->slot(0), this->_current_size, pos, count);
+        this->_current_size = static_cast<size_type>(this->_current_size - count);
+    }
+
+    /// @brief Construct a value in place at index `pos` without any checks
+    /// @warning DOES NOT BOUNDS CHECK: the vector must not be full and `pos` must not be larger than the size
+    template <typename... Args>
+    constexpr T& unchecked_emplace(size_t pos, Args&&... args) {
+        if (pos == this->_current_size) return this->unchecked_emplace_back(std::forward<Args>(args)...);
+        // Build the value before shifting: the arguments may refer to elements of this vector, and a throwing
+        // constructor must leave the vector untouched
+        T val(std::forward<Args>(args)...);
+        T& elem = base::insert_at(this->slot(0), this->_current_size, pos, std::move(val));
+        ++this->_current_size;
+        return elem;
+    }
+
+    /**
+     * @brief Copy-construct the `n` elements starting at `first` at the end without checking capacity
+     *
+     * Contiguous ranges of trivially copyable `T` are copied with a single `memcpy`. Otherwise the size grows one
+     * element at a time, so if a constructor throws the elements copied so far stay
+     * @warning DOES NOT BOUNDS CHECK
+     */
+    template <typename It>
+    constexpr void unchecked_append_n(It first, size_t n) {
+        if constexpr (fixed_vector_detail::memcpy_range_v<It, T>) {
+            fixed_vector_detail::copy_construct_n(std::to_address(first), n, this->slot(this->_current_size));
+            this->_current_size = static_cast<size_type>(this->_current_size + n);
+        } else {
+            for (size_t i = 0; i < n; ++i, ++first) this->unchecked_emplace_back(*first);
+        }
+    }
+
+    /// @brief Append every element of `[first, last)`, checking the capacity once when the length is known up front
+    template <typename It, typename S>
+    constexpr void append_impl(It first, S last, const char* what) {
+        if constexpr (std::forward_iterator<It>) {
+            const auto n = static_cast<size_t>(std::ranges::distance(first, last));
+            fixed_vector_detail::check<Policy>(n > CAPACITY - this->_current_size, fixed_vector_error::too_many,
+                                               what, this->_current_size + n, CAPACITY);
+            this->unchecked_append_n(std::move(first), n);
+        } else {
+            for (; first != last; ++first) {
+                fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full, what,
+                                                   CAPACITY);
+                this->unchecked_emplace_back(*first);
+            }
+        }
+    }
+
+    /// @brief Run `f`, and if it throws, destroy the elements past `old_size` before rethrowing
+    template <typename F>
+    constexpr void roll_back_on_throw(size_type old_size, F f) {
+#if FIXED_VECTOR_EXCEPTIONS
+        try {
+            f();
+        } catch (...) {
+            this->destroy_from(old_size);
+            throw;
+        }
+#else
+        (void)old_size;
+        f();
+#endif
+    }
+
+    /**
+     * @brief Insert the elements of `[first, last)` at index `pos`
+     *
+     * When the length is known up front and copying cannot throw, the tail is shifted once and the elements are
+     * constructed straight into the gap. Otherwise they are appended and rotated into place, and the vector is left
+     * as it was if a copy throws or the capacity runs out
+     */
+    template <typename It, typename S>
+    constexpr void insert_impl(size_t pos, It first, S last) {
+        fixed_vector_detail::check<Policy>(pos > this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot insert", pos, this->_current_size);
+        if constexpr (std::forward_iterator<It> && std::is_nothrow_constructible_v<T, std::iter_reference_t<It>>) {
+            const auto n = static_cast<size_t>(std::ranges::distance(first, last));
+            fixed_vector_detail::check<Policy>(n > CAPACITY - this->_current_size, fixed_vector_error::too_many,
+                                               "Cannot insert", this->_current_size + n, CAPACITY);
+            if (n == 0) return;
+            this->unsafe_right_shift(pos, n);
+            if constexpr (fixed_vector_detail::memcpy_range_v<It, T>) {
+                fixed_vector_detail::copy_construct_n(std::to_address(first), n, this->slot(pos));
+            } else {
+                for (T* dst = this->slot(pos); first != last; ++first, ++dst) std::construct_at(dst, *first);
+            }
+        } else {
+            const size_type old_size = this->_current_size;
+            this->roll_back_on_throw(old_size, [&] { this->append_impl(std::move(first), last, "Cannot insert"); });
+            std::rotate(this->slot(pos), this->slot(old_size), this->slot(this->_current_size));
+        }
     }
 
 public:
-    /// @brief Default constructor. Initial size will be 0
-    fixed_vector()
-        : _capacity(CAPACITY),
-          _current_size(0),
-          _buf({})
+    /// @brief Default constructor. Initial size will be 0 and no element is constructed
+    constexpr fixed_vector()
+        : _current_size(0)
     {}
 
     /// @brief Copy constructor
     /// @param v The `fixed_vector` to copy. Size will be the same as `v`
-    constexpr fixed_vector(const fixed_vector& v)
-        : _capacity(v._capacity),
-          _current_size(v._current_size),
-          _buf(v._buf)
-    {}
+    constexpr fixed_vector(const fixed_vector& v) requires std::is_copy_constructible_v<T>
+        : _current_size(0)
+    {
+        fixed_vector_detail::copy_construct_n(v.slot(0), v._current_size, this->slot(0));
+        this->_current_size = v._current_size;
+    }
 
     /// @brief Move constructor: allows vectors to be moved around conveniently
-    /// @param v The `fixed_vector` to move into this object
-    constexpr fixed_vector(fixed_vector&& v) noexcept
-        : _capacity(v._capacity),
-          _current_size(v._current_size),
-          _buf(std::move(v._buf))
-    {}
+    /// @param v The `fixed_vector` to move into this object. Its elements are left in a moved-from state
+    constexpr fixed_vector(fixed_vector&& v) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : _current_size(0)
+    {
+        fixed_vector_detail::move_construct_n(v.slot(0), v._current_size, this->slot(0));
+        this->_current_size = v._current_size;
+    }
 
     /// @brief Move constructor: allows a `std::array<T, CAPACITY>` to be converted into a `fixed_vector`
     /// @param a The `std::array<T, CAPACITY>` to move into this object
-    explicit fixed_vector(std::array<T, CAPACITY> &&a)
-        : _capacity(CAPACITY),
-          _current_size(CAPACITY),
-          _buf(std::move(a))
-    {}
+    explicit constexpr fixed_vector(std::array<T, CAPACITY> &&a)
+        : _current_size(0)
+    {
+        fixed_vector_detail::move_construct_n(a.data(), CAPACITY, this->slot(0));
+        this->_current_size = CAPACITY;
+    }
 
     /// @brief Initializer list constructor: allows initialization of `fixed_vector` using curly brace lists
     /// @param init_list An initializer list in curly braces, e.g. {1, 2, 3, 6, 12, ...}
-    fixed_vector(std::initializer_list<T> init_list)
-        : _capacity(CAPACITY),
-          _current_size(init_list.size()),
-          _buf({})
+    constexpr fixed_vector(std::initializer_list<T> init_list)
+        : _current_size(0)
     {
-        // Compiler should check initializer list size vs capacity for us
-        std::copy(init_list.begin(), init_list.end(), _buf.begin());
+        // A throwing constructor never runs the destructor: the elements copied so far must be destroyed here
+        this->roll_back_on_throw(0, [&] { this->append_impl(init_list.begin(), init_list.end(), "Cannot construct"); });
     }
 
+    /// @brief Range constructor: copies the elements of `[first, last)`
+    /// @param first, last The range to copy. Its length is checked against the capacity once when it can be measured
+    template <std::input_iterator It>
+    constexpr fixed_vector(It first, It last)
+        : _current_size(0)
+    {
+        // A throwing constructor never runs the destructor: the elements copied so far must be destroyed here
+        this->roll_back_on_throw(0, [&] { this->append_impl(std::move(first), last, "Cannot construct"); });
+    }
+
+    /// @brief Destructor for trivially destructible types: nothing to do
+    constexpr ~fixed_vector() requires std::is_trivially_destructible_v<T> = default;
+
+    /// @brief Destructor: destroys every live element
+    constexpr ~fixed_vector() { this->destroy_from(0); }
+
     /// @brief Get the fixed vector capacity
-    [[nodiscard]] size_t capacity() const { return this->_capacity; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return CAPACITY; }
+
+    /**
+     * @brief Get the number of element slots in the storage, which is at least `capacity()`
+     *
+     * The storage spans whole `ALIGNMENT`-byte blocks, so a kernel may load or store full vectors over
+     * `[0, padded_capacity())` and mask off the lanes past `size()` instead of peeling the tail.
+     * Slots past `size()` hold no live objects: only their bytes may be used
+     */
+    [[nodiscard]] static constexpr size_t padded_capacity() noexcept { return PADDED_CAPACITY; }
 
     /// @brief Get the fixed vector current logical size
-    [[nodiscard]] size_t size() const { return this->_current_size; }
+    [[nodiscard]] constexpr size_t size() const { return this->_current_size; }
 
-    /// @brief Clear the fixed vector logical contents. Does not destory any of the contents
-    void clear() { this->_current_size = 0; }
+    /// @brief Clear the fixed vector logical contents, destroying every live element
+    constexpr void clear() { this->destroy_from(0); }
 
-    /// @brief Get a pointer to the underlying array
-    [[nodiscard]] T* data() { return &(this->_buf[0]); }
+    /// @brief Get a pointer to the underlying storage
+    [[nodiscard]] constexpr T* data() { return this->slot(0); }
 
-    /// @brief Get a const pointer to the underlying array
-    [[nodiscard]] const T* cdata() { return &(this->_buf[0]); }
+    /// @brief Get a const pointer to the underlying storage
+    [[nodiscard]] constexpr const T* data() const { return this->slot(0); }
 
-    /// @brief Get a const reference to the underlying `std::array<T, CAPACITY>`
-    const std::array<T, CAPACITY>& array() const { return _buf; }
+    /// @brief Get a const pointer to the underlying storage
+    [[nodiscard]] constexpr const T* cdata() const { return this->slot(0); }
 
-    /// @brief Get a mutable reference to the underlying `std::array<T, CAPACITY>`
-    std::array<T, CAPACITY>& array_mut() { return this->_buf; }
+    /// @brief Construct a value in place at the end of the fixed vector, increasing the logical size by 1
+    /// @param args The arguments to forward to the constructor of `T`
+    /// @return A reference to the new element
+    template <typename... Args>
+    constexpr T& emplace_back(Args&&... args) {
+        fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full,
+                                           "Cannot push back", CAPACITY);
+        return this->unchecked_emplace_back(std::forward<Args>(args)...);
+    }
 
-    /// @brief Add a value to the end of the fixed vector, increasing the logical size by 1
-    /// @param val The value to add
-    void push_back(T val) {
-        if (this->_current_size == this->_capacity) {
-#ifndef FIXED_VECTOR_NOEXCEPT
-            const auto fmt = "Cannot push back: vector is at capacity %zu";
-            char msg[128] = {};
-            std::memset(msg, 0, 128);
-            std::snprintf(msg, 128, fmt, this->_capacity);
-            throw std::length_error("Cannot push back: vector is at capacity");
-#else
-            // WARNING: Defining `FIXED_VECTOR_NOEXCEPT` does no bounds checking!!!
-            // TODO: Implment some kind of no-exception bounds checking!
-            return;
-#endif
-        }
-        this->_buf[this->_current_size] = val;
-        ++this->_current_size;
+    /// @brief Construct a value in place at index `pos`, shifting every later value to the right
+    /// @param pos The index the new element will have. Must not be larger than `size()`
+    /// @param args The arguments to forward to the constructor of `T`
+    /// @return A reference to the new element
+    template <typename... Args>
+    constexpr T& emplace(size_t pos, Args&&... args) {
+        fixed_vector_detail::check<Policy>(this->_current_size == CAPACITY, fixed_vector_error::full,
+                                           "Cannot insert", CAPACITY);
+        fixed_vector_detail::check<Policy>(pos > this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot insert", pos, this->_current_size);
+        return this->unchecked_emplace(pos, std::forward<Args>(args)...);
     }
 
-    /// @brief Add a value to the front of the fixed vector, increasing the logical size by 1
+    /// @brief Construct a value in place at the front of the fixed vector, increasing the logical size by 1
+    /// @param args The arguments to forward to the constructor of `T`
+    /// @return A reference to the new element
+    /// @warning Shifts every value in the array to the right: could be costly for large arrays
+    template <typename... Args>
+    constexpr T& emplace_front(Args&&... args) { return this->emplace(0, std::forward<Args>(args)...); }
+
+    /// @brief Copy a value to the end of the fixed vector, increasing the logical size by 1
+    /// @param val The value to add
+    constexpr void push_back(const T& val) { this->emplace_back(val); }
+
+    /// @brief Move a value to the end of the fixed vector, increasing the logical size by 1
+    /// @param val The value to add
+    constexpr void push_back(T&& val) { this->emplace_back(std::move(val)); }
+
+    /// @brief Copy a value to the front of the fixed vector, increasing the logical size by 1
     /// @param val The value to add
     /// @warning Shifts every value in the array to the right: could be costly for large arrays
-    void push_front(T val) {
-        if (this->_current_size == this->_capacity) {
-#ifndef FIXED_VECTOR_NOEXCEPT
-            const auto fmt = "Cannot push back: vector is at capacity %zu";
-            char msg[128] = {};
-            std::memset(msg, 0, 128);
-            std::snprintf(msg, 128, fmt, this->_capacity);
-            throw std::length_error("Cannot push back: vector is at capacity");
-#else
-            // WARNING: Defining `FIXED_VECTOR_NOEXCEPT` does no bounds checking!!!
-            // TODO: Implment some kind of no-exception bounds checking!
-            return;
-#endif
-        }
-        // Should be fine since we checked bounds already
-        this->unsafe_right_shift_by_one();
-        this->_buf[0] = val;
-    }
+    constexpr void push_front(const T& val) { this->emplace(0, val); }
+
+    /// @brief Move a value to the front of the fixed vector, increasing the logical size by 1
+    /// @param val The value to add
+    /// @warning Shifts every value in the array to the right: could be costly for large arrays
+    constexpr void push_front(T&& val) { this->emplace(0, std::move(val)); }
 
     /// @brief Add a value to the end of the fixed vector, decreasing the logical size by 1
     /// @return The value previously at the back
-    [[nodiscard]] T pop_back() {
-#ifndef FIXED_VECTOR_NOEXCEPT
-        if (this->_current_size == 0) throw std::length_error("Cannot pop back: vector is empty");
-#else
-        /*
-         * WARNING: Defining `FIXED_VECTOR_NOEXCEPT` does not do proper bounds checking!!!
-         * If empty, it returns whatever the zeroth element is since CAPACITY is always at least 1
-         */
-        // TODO: Implment some kind of no-exception bounds checking!
-        if (this->_current_size == 0) return this->_buf[0];
-#endif
-        --this->_current_size;
-        return std::move(this->_buf[this->_current_size]);
+    [[nodiscard]] constexpr T pop_back() {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop back");
+        return this->unchecked_pop_back();
     }
 
     /// @brief Remove a value from the front of the fixed vector, decreasing the logical size by 1
     /// @return The value previously at the front
     /// @warning Shifts every value in the array to the left: could be costly for large arrays
-    [[nodiscard]] T pop_front() {
-#ifndef FIXED_VECTOR_NOEXCEPT
-        if (this->_current_size == 0) throw std::length_error("Cannot pop back: vector is empty");
-        /*
-         * WARNING: Defining `FIXED_VECTOR_NOEXCEPT` does not do proper bounds checking!!!
-         * If empty, it returns whatever the zeroth element is since CAPACITY is always at least 1
-         */
-        // TODO: Implment some kind of no-exception bounds checking!
-#endif
-        T val = this->_buf[0];
-        this->unsafe_left_shift_by_one();
-        return std::move(val);
+    [[nodiscard]] constexpr T pop_front() {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop front");
+        return this->unchecked_pop_front();
     }
 
-    /// @brief Reverse the fixed vector contents in-place
-    void reverse() {
-        T temp;
-        for (size_t i = 0; i <= this->_current_size / 2; ++i) {
-            temp = this->_buf[i];
-            this->_buf[i] = this->_buf[this->_current_size - 1 - i];
-            this->_buf[this->_current_size - 1 - i] = temp;
+    /*
+     * Bulk API: each call checks the capacity once and shifts the tail at most once, instead of once per element.
+     * Contiguous ranges of trivially copyable elements are copied with `memcpy`
+     */
+
+    /// @brief Replace the contents with the elements of `[first, last)`
+    /// @warning `[first, last)` must not be part of this vector
+    template <std::input_iterator It>
+    constexpr void assign(It first, It last) {
+        if constexpr (std::forward_iterator<It>) {
+            const auto n = static_cast<size_t>(std::distance(first, last));
+            fixed_vector_detail::check<Policy>(n > CAPACITY, fixed_vector_error::too_many, "Cannot assign", n,
+                                               CAPACITY);
+            this->destroy_from(0);
+            this->unchecked_append_n(std::move(first), n);
+        } else {
+            this->destroy_from(0);
+            this->append_impl(std::move(first), last, "Cannot assign");
         }
     }
 
-    /// @brief Allow square-bracket indexing like a `std::vector`
-    T& operator[](size_t pos) {
-        if (this->_current_size == 0 || pos > this->_current_size - 1) {
-#ifndef FIXED_VECTOR_NOEXCEPT
-            const auto fmt = "Index %zu is out of range for current size %zu";
-            char msg[128] = {};
-            std::memset(msg, 0, 128);
-            std::snprintf(msg, 128, fmt, pos, this->_current_size);
-            throw std::out_of_range("Index is out of range for current size");
-#else
-            /*
-             * WARNING: Defining `FIXED_VECTOR_NOEXCEPT` does not do proper bounds checking!!!
-             * If empty, it returns whatever the zeroth element is since CAPACITY is always at least 1
-             */
-            // TODO: Implment some kind of no-exception bounds checking!
-            return this->_buf[0];
-#endif
-        }
-        if (this->_current_size > this->_capacity) {
-#ifndef FIXED_VECTOR_NOEXCEPT
-            // This should never happen, but fail loudly if it does
-            const auto fmt = "Current size %zu is somehow larger than capacity %zu: something is very wrong!";
-            char msg[128] = {};
-            std::memset(msg, 0, 128);
-            std::snprintf(msg, 128, fmt, this->_current_size, this->_capacity);
-            throw std::runtime_error("Current size is somehow larger than capacity: something is very wrong!");
-#else
-            /*
-             * WARNING: Defining `FIXED_VECTOR_NOEXCEPT` does not do proper bounds checking!!!
-             * If empty, it returns whatever the zeroth element is since CAPACITY is always at least 1
-             */
-            // TODO: Implment some kind of no-exception bounds checking!
-            return this->_buf[0];
-#endif
-        }
-        return this->_buf[pos];
+    /// @brief Replace the contents with the elements of an initializer list
+    constexpr void assign(std::initializer_list<T> init_list) { this->assign(init_list.begin(), init_list.end()); }
+
+    /// @brief Copy the elements of `[first, last)` to the end of the fixed vector
+    /// @warning `[first, last)` must not be part of this vector
+    template <std::input_iterator It>
+    constexpr void append(It first, It last) { this->append_impl(std::move(first), last, "Cannot append"); }
+
+    /// @brief Copy the elements of `range` to the end of the fixed vector
+    /// @warning `range` must not be part of this vector
+    template <std::ranges::input_range R>
+    constexpr void append_range(R&& range) {
+        this->append_impl(std::ranges::begin(range), std::ranges::end(range), "Cannot append");
     }
 
-    /// @brief Allow const square-bracket indexing like a `std::vector`
-    const T& operator[](size_t pos) const {
-        if (this->_current_size == 0 || pos > this->_current_size - 1) {
-#ifndef FIXED_VECTOR_NOEXCEPT
-            const auto fmt = "Index %zu is out of range for current size %zu";
-            char msg[128] = {};
-            std::memset(msg, 0, 128);
-            std::snprintf(msg, 128, fmt, pos, this->_current_size);
-            throw std::out_of_range("Index is out of range for current size");
-#else
-            /*
-             * WARNING: Defining `FIXED_VECTOR_NOEXCEPT` does not do proper bounds checking!!!
-             * If empty, it returns whatever the zeroth element is since CAPACITY is always at least 1
-             */
-            // TODO: Implment some kind of no-exception bounds checking!
-            return this->_buf[0];
-#endif
+    /// @brief Insert the elements of `[first, last)` at index `pos`, shifting every later value to the right once
+    /// @param pos The index the first new element will have. Must not be larger than `size()`
+    /// @warning `[first, last)` must not be part of this vector
+    template <std::input_iterator It>
+    constexpr void insert(size_t pos, It first, It last) { this->insert_impl(pos, std::move(first), last); }
+
+    /// @brief Insert the elements of an initializer list at index `pos`, shifting every later value to the right once
+    constexpr void insert(size_t pos, std::initializer_list<T> init_list) {
+        this->insert_impl(pos, init_list.begin(), init_list.end());
+    }
+
+    /// @brief Destroy the element at index `pos`, shifting every later value to the left
+    constexpr void erase(size_t pos) { this->erase(pos, pos + 1); }
+
+    /// @brief Destroy the elements at indices `[first, last)`, shifting every later value to the left once
+    constexpr void erase(size_t first, size_t last) {
+        fixed_vector_detail::check<Policy>(first > last || last > this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot erase", last, this->_current_size);
+        if (first != last) this->unsafe_left_shift(first, last - first);
+    }
+
+    /*
+     * Overwrite API: for filling the storage in place, e.g. straight from `read()`, `recv()` or a decoder, instead of
+     * filling a separate buffer and copying it in
+     */
+
+    /**
+     * @brief Resize to `n` elements, default-initializing new ones
+     *
+     * For trivial element types new elements are left uninitialized, ready to be overwritten, and growing costs only
+     * the size update
+     */
+    constexpr void resize_for_overwrite(size_t n) {
+        fixed_vector_detail::check<Policy>(n > CAPACITY, fixed_vector_error::too_many, "Cannot resize", n, CAPACITY);
+        if (n <= this->_current_size) {
+            this->destroy_from(static_cast<size_type>(n));
+            return;
         }
-        if (this->_current_size > this->_capacity) {
-#ifndef FIXED_VECTOR_NOEXCEPT
-            // This should never happen, but fail loudly if it does
-            const auto fmt = "Current size %zu is somehow larger than capacity %zu: something is very wrong!";
-            char msg[128] = {};
-            std::memset(msg, 0, 128);
-            std::snprintf(msg, 128, fmt, this->_current_size, this->_capacity);
-            throw std::runtime_error("Current size is somehow larger than capacity: something is very wrong!");
-#else
-            /*
-             * WARNING: Defining `FIXED_VECTOR_NOEXCEPT` does not do proper bounds checking!!!
-             * If empty, it returns whatever the zeroth element is since CAPACITY is always at least 1
-             */
-            // TODO: Implment some kind of no-exception bounds checking!
-            return this->_buf[0];
-#endif
+        if constexpr (!std::is_trivially_default_constructible_v<T> || !std::is_trivially_destructible_v<T>) {
+            for (size_t i = this->_current_size; i < n; ++i) {
+                ::new (static_cast<void*>(this->slot(i))) T;
+                ++this->_current_size;
+            }
         }
-        return this->_buf[pos];
+        this->_current_size = static_cast<size_type>(n);
     }
 
-    /// @brief Allow another `fixed_vector` to be copied into this one using the `=` operator
-    fixed_vector& operator= (const fixed_vector& v) noexcept {
-        this->_current_size = v._current_size;
-        for (size_t i = 0; i < this->_buf.size(); ++i) this->_buf[i] = v._buf[i];
-        return *this;
+    /**
+     * @brief Get the unused storage past the last element, `[size(), capacity())`
+     *
+     * Write new elements there, then `commit()` them:
+     * @code
+     * auto tail = packet.uninitialized_tail();
+     * packet.commit(static_cast<size_t>(::read(fd, tail.data(), tail.size_bytes())));
+     * @endcode
+     */
+    [[nodiscard]] constexpr std::span<T> uninitialized_tail() noexcept requires OVERWRITABLE {
+        return {this->slot(this->_current_size), CAPACITY - this->_current_size};
     }
 
-    /// @brief Allow another `fixed_vector` to be moved into this one using the `=` operator
-    fixed_vector& operator= (fixed_vector&& v) noexcept {
-        this->_current_size = v._current_size;
-        this->_buf = std::move(v._buf);
-        return *this;
+    /// @brief Make the first `n` slots of `uninitialized_tail()` part of the vector, increasing its size by `n`
+    constexpr void commit(size_t n) requires OVERWRITABLE {
+        fixed_vector_detail::check<Policy>(n > CAPACITY - this->_current_size, fixed_vector_error::too_many,
+                                           "Cannot commit", this->_current_size + n, CAPACITY);
+        this->_current_size = static_cast<size_type>(this->_current_size + n);
     }
 
-    /// @brief Allow two `fixed_vector`s to be compared using `==`
-    bool operator== (const fixed_vector& v) noexcept {
-        bool equals = false;
-        if (this->_current_size == v.size())
-            equals = std::equal(this->cbegin(), this->cend(), v.cbegin());
-        return equals;
+    /*
+     * Non-throwing API: these never consult the error policy. A full or empty vector, or a bad index, is reported
+     * through the return value instead, so they are usable with `-fno-exceptions`
+     */
+
+    /// @brief Construct a value in place at the end of the fixed vector if there is room
+    /// @param args The arguments to forward to the constructor of `T`
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    template <typename... Args>
+    constexpr T* try_emplace_back(Args&&... args) {
+        if (this->_current_size == CAPACITY) [[unlikely]] return nullptr;
+        return &this->unchecked_emplace_back(std::forward<Args>(args)...);
     }
 
-    /// @brief Allow two `fixed_vector`s to be compared using `==`
-    bool operator== (const fixed_vector& v) const noexcept {
-        bool equals = false;
-        if (this->_current_size == v.size())
-            equals = std::equal(this->cbegin(), this->cend(), v.cbegin());
-        return equals;
-    }
-
-    /// @class iterator
-    /// @brief Allows `fixed_vector` to be used with C++ standard iterator-based functions
-    class iterator {
-        T* _ptr;
-    public:
-        using value_type = T;
-        using difference_type = std::ptrdiff_t;
-        using pointer = T*;
-        using reference = T&;
-        using iterator_category = std::random_access_iterator_tag;
-
-        explicit iterator(T* ptr) : _ptr(ptr) {}
-
-        iterator operator++() {
-            ++_ptr;
-            return *this;
-        }
+    /// @brief Construct a value in place at the front of the fixed vector if there is room
+    /// @param args The arguments to forward to the constructor of `T`
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    /// @warning Shifts every value in the array to the right: could be costly for large arrays
+    template <typename... Args>
+    constexpr T* try_emplace_front(Args&&... args) {
+        if (this->_current_size == CAPACITY) [[unlikely]] return nullptr;
+        return &this->unchecked_emplace(0, std::forward<Args>(args)...);
+    }
 
-        iterator operator++(int) {
-            iterator tmp = *this;
-            ++_ptr;
-            return tmp;
-        }
+    /// @brief Copy a value to the end of the fixed vector if there is room
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    constexpr T* try_push_back(const T& val) { return this->try_emplace_back(val); }
 
-        T& operator*() {
-            return *_ptr;
-        }
+    /// @brief Move a value to the end of the fixed vector if there is room. `val` is untouched if there is not
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    constexpr T* try_push_back(T&& val) { return this->try_emplace_back(std::move(val)); }
 
-        T* operator->() {
-            return _ptr;
-        }
+    /// @brief Copy a value to the front of the fixed vector if there is room
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    constexpr T* try_push_front(const T& val) { return this->try_emplace_front(val); }
 
-        bool operator==(const iterator& other) const {
-            return _ptr == other._ptr;
-        }
+    /// @brief Move a value to the front of the fixed vector if there is room. `val` is untouched if there is not
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    constexpr T* try_push_front(T&& val) { return this->try_emplace_front(std::move(val)); }
 
-        bool operator!=(const iterator& other) const {
-            return _ptr != other._ptr;
-        }
+    /// @brief Remove the value at the back of the fixed vector if there is one
+    /// @return The value previously at the back, or `std::nullopt` if the vector was empty
+    [[nodiscard]] constexpr std::optional<T> try_pop_back() {
+        if (this->_current_size == 0) [[unlikely]] return std::nullopt;
+        return this->unchecked_pop_back();
+    }
 
-        friend iterator operator+(difference_type n, const iterator& it) { return it + n; }
+    /// @brief Remove the value at the front of the fixed vector if there is one
+    /// @return The value previously at the front, or `std::nullopt` if the vector was empty
+    [[nodiscard]] constexpr std::optional<T> try_pop_front() {
+        if (this->_current_size == 0) [[unlikely]] return std::nullopt;
+        return this->unchecked_pop_front();
+    }
 
-        friend iterator operator+(const iterator& it, difference_type n) {
-            iterator temp = it;
-            temp += n;
-            return temp;
-        }
+    /// @brief Get a pointer to the element at `pos`, or `nullptr` if `pos` is out of range
+    [[nodiscard]] constexpr T* try_at(size_t pos) { return pos < this->_current_size ? this->slot(pos) : nullptr; }
 
-        friend iterator operator-(difference_type n, const iterator& it) {
-            iterator temp = it;
-            temp -= n;
-            return temp;
-        }
+    /// @brief Get a const pointer to the element at `pos`, or `nullptr` if `pos` is out of range
+    [[nodiscard]] constexpr const T* try_at(size_t pos) const { return pos < this->_current_size ? this->slot(pos) : nullptr; }
 
-        friend difference_type operator-(const iterator& lhs, const iterator& rhs) { return lhs._ptr - rhs._ptr; }
-    };
+    /*
+     * Unchecked API: for callers that have already established the precondition, e.g. by checking `size()` once
+     * before a batch of pushes. Violating the precondition is undefined behaviour regardless of the error policy
+     */
 
-    /// @class const_iterator
-    /// @brief Allows `fixed_vector` to be used with C++ standard const-iterator-based functions
-    class const_iterator {
-        const T* _ptr;
-    public:
-        using value_type = T;
-        using difference_type = std::ptrdiff_t;
-        using pointer = T*;
-        using reference = T&;
-        using iterator_category = std::random_access_iterator_tag;
-
-        explicit const_iterator(const T* ptr) : _ptr(ptr) {}
-
-        const_iterator operator++() {
-            ++_ptr;
-            return *this;
-        }
+    /// @brief Construct a value in place at the end of the fixed vector without checking capacity
+    /// @param args The arguments to forward to the constructor of `T`
+    /// @return A reference to the new element
+    /// @warning DOES NOT BOUNDS CHECK: the vector must not be full
+    template <typename... Args>
+    constexpr T& unchecked_emplace_back(Args&&... args) {
+        // Keep the size in a local: storing the new element may alias `_current_size` and force a reload otherwise
+        const size_type size = this->_current_size;
+        T* elem = std::construct_at(this->slot(size), std::forward<Args>(args)...);
+        this->_current_size = static_cast<size_type>(size + 1);
+        return *elem;
+    }
 
-        const_iterator operator++(int) {
-            const_iterator tmp = *this;
-            ++_ptr;
-            return tmp;
-        }
+    /// @brief Copy a value to the end of the fixed vector without checking capacity
+    /// @warning DOES NOT BOUNDS CHECK: the vector must not be full
+    constexpr T& unchecked_push_back(const T& val) { return this->unchecked_emplace_back(val); }
 
-        const T& operator*() {
-            return *_ptr;
-        }
+    /// @brief Move a value to the end of the fixed vector without checking capacity
+    /// @warning DOES NOT BOUNDS CHECK: the vector must not be full
+    constexpr T& unchecked_push_back(T&& val) { return this->unchecked_emplace_back(std::move(val)); }
 
-        const T* operator->() {
-            return _ptr;
-        }
+    /// @brief Remove the value at the back of the fixed vector without checking for emptiness
+    /// @warning DOES NOT BOUNDS CHECK: the vector must not be empty
+    [[nodiscard]] constexpr T unchecked_pop_back() {
+        T val = std::move(*this->slot(this->_current_size - 1));
+        // A single element: destroy it inline rather than through the out-of-line `destroy_n`
+        std::destroy_at(this->slot(this->_current_size - 1));
+        --this->_current_size;
+        return val;
+    }
 
-        bool operator==(const const_iterator& other) const {
-            return _ptr == other._ptr;
-        }
+    /// @brief Remove the value at the front of the fixed vector without checking for emptiness
+    /// @warning DOES NOT BOUNDS CHECK: the vector must not be empty
+    [[nodiscard]] constexpr T unchecked_pop_front() {
+        T val = std::move(*this->slot(0));
+        base::erase_at(this->slot(0), this->_current_size, 0, 1);
+        --this->_current_size;
+        return val;
+    }
 
-        bool operator!=(const const_iterator& other) const {
-            return _ptr != other._ptr;
-        }
+    /// @brief Reverse the fixed vector contents in-place
+    constexpr void reverse() { std::reverse(this->slot(0), this->slot(this->_current_size)); }
 
-        friend const_iterator operator+(difference_type n, const const_iterator& it) { return it + n; }
+    /// @brief Allow square-bracket indexing like a `std::vector`
+    constexpr T& operator[](size_t pos) {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range, "Cannot access",
+                                           pos, this->_current_size);
+        return *this->slot(pos);
+    }
 
-        friend const_iterator operator+(const const_iterator& it, difference_type n) {
-            const_iterator temp = it;
-            temp += n;
-            return temp;
-        }
+    /// @brief Allow const square-bracket indexing like a `std::vector`
+    constexpr const T& operator[](size_t pos) const {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range, "Cannot access",
+                                           pos, this->_current_size);
+        return *this->slot(pos);
+    }
 
-        friend const_iterator operator-(difference_type n, const const_iterator& it) {
-            const_iterator temp = it;
-            temp -= n;
-            return temp;
-        }
+    /**
+     * @brief Allow another `fixed_vector` to be copied into this one using the `=` operator
+     *
+     * Only the live elements of `v` are touched: elements both vectors hold are copy-assigned, extra elements of `v`
+     * are copy-constructed and surplus elements of this vector are destroyed
+     */
+    constexpr fixed_vector& operator= (const fixed_vector& v) requires std::is_copy_constructible_v<T> {
+        if (this == &v) return *this;
+        base::template assign<false>(this->slot(0), this->_current_size, v.slot(0), v._current_size);
+        this->_current_size = v._current_size;
+        return *this;
+    }
 
-        friend difference_type operator-(const const_iterator& lhs, const const_iterator& rhs) { return lhs._ptr - rhs._ptr; }
-    };
+    /**
+     * @brief Allow another `fixed_vector` to be moved into this one using the `=` operator
+     *
+     * Only the live elements of `v` are touched, which are left in a moved-from state
+     */
+    constexpr fixed_vector& operator= (fixed_vector&& v) noexcept(std::is_nothrow_move_assignable_v<T> &&
+                                                        std::is_nothrow_move_constructible_v<T>) {
+        if (this == &v) return *this;
+        base::template assign<true>(this->slot(0), this->_current_size, v.slot(0), v._current_size);
+        this->_current_size = v._current_size;
+        return *this;
+    }
 
-    /// @brief Get mutable iterator to beginning
-    iterator begin() {
-        return iterator(_buf.data());
+    /**
+     * @brief Swap the contents of two `fixed_vector`s
+     *
+     * Only the live elements are touched: the common prefix is swapped element-wise and the longer vector's
+     * remaining elements are moved across and destroyed at their source
+     */
+    constexpr void swap(fixed_vector& v) noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+        if (this == &v) return;
+        base::swap_ranges(this->slot(0), this->_current_size, v.slot(0), v._current_size);
+        std::swap(this->_current_size, v._current_size);
     }
 
-    /// @brief Get mutable iterator to end
-    iterator end() {
-        return iterator(_buf.data() + _current_size);
+    /// @brief Swap the contents of two `fixed_vector`s, touching only their live elements
+    friend constexpr void swap(fixed_vector& a, fixed_vector& b) noexcept(noexcept(a.swap(b))) { a.swap(b); }
+
+    /// @brief Allow two `fixed_vector`s to be compared using `==`
+    constexpr bool operator== (const fixed_vector& v) noexcept {
+        return this->_current_size == v._current_size && base::equal(this->slot(0), v.slot(0), this->_current_size);
     }
 
-    /// @brief Get const iterator to beginning
-    const_iterator cbegin() const {
-        return const_iterator(_buf.data());
+    /// @brief Allow two `fixed_vector`s to be compared using `==`
+    constexpr bool operator== (const fixed_vector& v) const noexcept {
+        return this->_current_size == v._current_size && base::equal(this->slot(0), v.slot(0), this->_current_size);
     }
 
+    /// @brief Get mutable iterator to beginning
+    constexpr iterator begin() { return this->slot(0); }
+
+    /// @brief Get mutable iterator to end
+    constexpr iterator end() { return this->slot(this->_current_size); }
+
+    /// @brief Get const iterator to beginning
+    constexpr const_iterator cbegin() const { return this->slot(0); }
+
     /// @brief Get const iterator to end
-    const_iterator cend() const {
-        return const_iterator(_buf.data() + _current_size);
-    }
+    constexpr const_iterator cend() const { return this->slot(this->_current_size); }
 
     /// @brief Overload for getting const iterator to beginning
-    const_iterator begin() const {
-        return cbegin();
-    }
+    constexpr const_iterator begin() const { return cbegin(); }
 
     /// @brief Overload for getting const iterator to end
-    const_iterator end() const {
-        return cend();
-    }
+    constexpr const_iterator end() const { return cend(); }
+
+    /// @brief Get mutable reverse iterator to the last element
+    constexpr reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+
+    /// @brief Get mutable reverse iterator to before the first element
+    constexpr reverse_iterator rend() { return reverse_iterator(this->begin()); }
+
+    /// @brief Get const reverse iterator to the last element
+    constexpr const_reverse_iterator crbegin() const { return const_reverse_iterator(this->cend()); }
+
+    /// @brief Get const reverse iterator to before the first element
+    constexpr const_reverse_iterator crend() const { return const_reverse_iterator(this->cbegin()); }
+
+    /// @brief Overload for getting const reverse iterator to the last element
+    constexpr const_reverse_iterator rbegin() const { return crbegin(); }
+
+    /// @brief Overload for getting const reverse iterator to before the first element
+    constexpr const_reverse_iterator rend() const { return crend(); }
 };
 
 #endif //FIXED_VECTOR_HPP
@@ -0,0 +1,215 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef FIXED_VECTOR_REF_HPP
+#define FIXED_VECTOR_REF_HPP
+
+#include "fixed_vector.hpp"
+
+#include <span>
+
+/**
+ * @class fixed_vector_ref
+ * @brief A non-owning, mutable view of any `fixed_vector<T, N>` that erases its capacity
+ *
+ * Functions taking a `fixed_vector_ref<T>` are instantiated once per element type instead of once per capacity, so
+ * they can be compiled out of line in a single translation unit. The view can grow and shrink the vector it refers to
+ * up to that vector's capacity, and must not outlive it.
+ *
+ * Every `fixed_vector` stores its size in the smallest type that can hold its capacity, so the view keeps a pointer
+ * to the size along with its width and dispatches on the width whenever the size is read or written
+ * @tparam T The element type
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types. Independent of the policy of
+ * the viewed vector
+ */
+template <typename T, typename Policy = fixed_vector_policy::default_policy>
+class fixed_vector_ref : private fixed_vector_base<T> {
+    using base = fixed_vector_base<T>;
+
+public:
+    using size_type = size_t;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using difference_type = std::ptrdiff_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+private:
+    /// @brief The element storage of the viewed vector
+    T* _data;
+    /// @brief The size of the viewed vector, one member per possible width of its `size_type`
+    union {
+        std::uint8_t* _size8;
+        std::uint16_t* _size16;
+        std::uint32_t* _size32;
+        std::uint64_t* _size64;
+    };
+    /// @brief The capacity of the viewed vector
+    size_t _capacity;
+    /// @brief Which member of the size union is active: the width of the size in bytes
+    std::uint8_t _width;
+
+    /// @brief Read the size of the viewed vector
+    constexpr size_t load_size() const noexcept {
+        switch (this->_width) {
+            case 1: return *this->_size8;
+            case 2: return *this->_size16;
+            case 4: return *this->_size32;
+            default: return static_cast<size_t>(*this->_size64);
+        }
+    }
+
+    /// @brief Write the size of the viewed vector. `size` must not exceed the capacity
+    constexpr void store_size(size_t size) noexcept {
+        switch (this->_width) {
+            case 1: *this->_size8 = static_cast<std::uint8_t>(size); break;
+            case 2: *this->_size16 = static_cast<std::uint16_t>(size); break;
+            case 4: *this->_size32 = static_cast<std::uint32_t>(size); break;
+            default: *this->_size64 = size; break;
+        }
+    }
+
+public:
+    /// @brief View a `fixed_vector` of any capacity, error policy or alignment
+    template <size_t CAPACITY, typename VPolicy, size_t ALIGNMENT>
+    constexpr fixed_vector_ref(fixed_vector<T, CAPACITY, VPolicy, ALIGNMENT>& v) noexcept
+        : _data(v.data()), _capacity(CAPACITY), _width(sizeof(v._current_size))
+    {
+        using vsize_t = decltype(v._current_size);
+        if constexpr (std::is_same_v<vsize_t, std::uint8_t>) this->_size8 = &v._current_size;
+        else if constexpr (std::is_same_v<vsize_t, std::uint16_t>) this->_size16 = &v._current_size;
+        else if constexpr (std::is_same_v<vsize_t, std::uint32_t>) this->_size32 = &v._current_size;
+        else this->_size64 = &v._current_size;
+    }
+
+    /// @brief Get the capacity of the viewed vector
+    [[nodiscard]] constexpr size_t capacity() const noexcept { return this->_capacity; }
+
+    /// @brief Get the current logical size of the viewed vector
+    [[nodiscard]] constexpr size_t size() const noexcept { return this->load_size(); }
+
+    /// @brief Whether the viewed vector holds no elements
+    [[nodiscard]] constexpr bool empty() const noexcept { return this->load_size() == 0; }
+
+    /// @brief Whether the viewed vector is at capacity
+    [[nodiscard]] constexpr bool full() const noexcept { return this->load_size() == this->_capacity; }
+
+    /// @brief Get a pointer to the elements of the viewed vector
+    [[nodiscard]] constexpr T* data() const noexcept { return this->_data; }
+
+    /// @brief Destroy every element of the viewed vector
+    constexpr void clear() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) base::destroy_n(this->_data, this->load_size());
+        this->store_size(0);
+    }
+
+    /// @brief Construct a value in place at the end of the viewed vector, increasing its logical size by 1
+    /// @param args The arguments to forward to the constructor of `T`
+    /// @return A reference to the new element
+    template <typename... Args>
+    constexpr T& emplace_back(Args&&... args) {
+        const size_t size = this->load_size();
+        fixed_vector_detail::check<Policy>(size == this->_capacity, fixed_vector_error::full, "Cannot push back",
+                                           this->_capacity);
+        T* elem = std::construct_at(this->_data + size, std::forward<Args>(args)...);
+        this->store_size(size + 1);
+        return *elem;
+    }
+
+    /// @brief Construct a value in place at index `pos`, shifting every later value to the right
+    /// @param pos The index the new element will have. Must not be larger than `size()`
+    /// @param args The arguments to forward to the constructor of `T`
+    /// @return A reference to the new element
+    template <typename... Args>
+    constexpr T& emplace(size_t pos, Args&&... args) {
+        const size_t size = this->load_size();
+        fixed_vector_detail::check<Policy>(size == this->_capacity, fixed_vector_error::full, "Cannot insert",
+                                           this->_capacity);
+        fixed_vector_detail::check<Policy>(pos > size, fixed_vector_error::out_of_range, "Cannot insert", pos, size);
+        // Build the value before shifting: the arguments may refer to elements of the vector
+        T val(std::forward<Args>(args)...);
+        T& elem = base::insert_at(this->_data, size, pos, std::move(val));
+        this->store_size(size + 1);
+        return elem;
+    }
+
+    /// @brief Copy a value to the end of the viewed vector, increasing its logical size by 1
+    constexpr void push_back(const T& val) { this->emplace_back(val); }
+
+    /// @brief Move a value to the end of the viewed vector, increasing its logical size by 1
+    constexpr void push_back(T&& val) { this->emplace_back(std::move(val)); }
+
+    /// @brief Copy a value to index `pos`, shifting every later value to the right
+    constexpr T& insert(size_t pos, const T& val) { return this->emplace(pos, val); }
+
+    /// @brief Move a value to index `pos`, shifting every later value to the right
+    constexpr T& insert(size_t pos, T&& val) { return this->emplace(pos, std::move(val)); }
+
+    /// @brief Construct a value in place at the end of the viewed vector if there is room
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    template <typename... Args>
+    constexpr T* try_emplace_back(Args&&... args) {
+        const size_t size = this->load_size();
+        if (size == this->_capacity) [[unlikely]] return nullptr;
+        T* elem = std::construct_at(this->_data + size, std::forward<Args>(args)...);
+        this->store_size(size + 1);
+        return elem;
+    }
+
+    /// @brief Copy a value to the end of the viewed vector if there is room
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    constexpr T* try_push_back(const T& val) { return this->try_emplace_back(val); }
+
+    /// @brief Move a value to the end of the viewed vector if there is room. `val` is untouched if there is not
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    constexpr T* try_push_back(T&& val) { return this->try_emplace_back(std::move(val)); }
+
+    /// @brief Remove the value at the back of the viewed vector, decreasing its logical size by 1
+    /// @return The value previously at the back
+    [[nodiscard]] constexpr T pop_back() {
+        const size_t size = this->load_size();
+        fixed_vector_detail::check<Policy>(size == 0, fixed_vector_error::empty, "Cannot pop back");
+        T val = std::move(this->_data[size - 1]);
+        std::destroy_at(this->_data + size - 1);
+        this->store_size(size - 1);
+        return val;
+    }
+
+    /// @brief Destroy the element at `pos`, shifting every later value to the left
+    constexpr void erase(size_t pos) { this->erase(pos, pos + 1); }
+
+    /// @brief Destroy the elements at indices `[first, last)`, shifting every later value to the left once
+    constexpr void erase(size_t first, size_t last) {
+        const size_t size = this->load_size();
+        fixed_vector_detail::check<Policy>(first > last || last > size, fixed_vector_error::out_of_range,
+                                           "Cannot erase", last, size);
+        if (first == last) return;
+        base::erase_at(this->_data, size, first, last - first);
+        this->store_size(size - (last - first));
+    }
+
+    /// @brief Allow square-bracket indexing like a `std::vector`
+    constexpr T& operator[](size_t pos) const {
+        fixed_vector_detail::check<Policy>(pos >= this->load_size(), fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->load_size());
+        return this->_data[pos];
+    }
+
+    /// @brief View the live elements as a span
+    constexpr operator std::span<T>() const noexcept { return {this->_data, this->load_size()}; }
+
+    /// @brief View the live elements as a read-only span
+    constexpr operator std::span<const T>() const noexcept { return {this->_data, this->load_size()}; }
+
+    /// @brief Get iterator to the first element
+    constexpr iterator begin() const noexcept { return this->_data; }
+
+    /// @brief Get iterator past the last element
+    constexpr iterator end() const noexcept { return this->_data + this->load_size(); }
+};
+
+#endif //FIXED_VECTOR_REF_HPP
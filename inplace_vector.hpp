@@ -0,0 +1,625 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef INPLACE_VECTOR_HPP
+#define INPLACE_VECTOR_HPP
+
+#include "fixed_vector.hpp"
+
+#include <compare>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+
+namespace fixed_vector_detail {
+#if FIXED_VECTOR_EXCEPTIONS
+    /// @brief Throw `std::bad_alloc`, which is what `std::inplace_vector` reports running out of capacity with
+    [[noreturn, gnu::cold, gnu::noinline]] inline void throw_bad_alloc() { throw std::bad_alloc(); }
+#endif
+
+    /// @brief Three-way compare with `<=>` when `T` has it, and with `<` otherwise, like the standard containers do
+    struct synth_three_way {
+        template <typename T>
+        constexpr auto operator()(const T& a, const T& b) const {
+            if constexpr (std::three_way_comparable<T>) {
+                return a <=> b;
+            } else {
+                if (a < b) return std::weak_ordering::less;
+                if (b < a) return std::weak_ordering::greater;
+                return std::weak_ordering::equivalent;
+            }
+        }
+    };
+}
+
+namespace fixed_vector_policy {
+    /**
+     * @brief Report errors the way `std::inplace_vector` does: `std::bad_alloc` when the capacity would be exceeded
+     * and `std::out_of_range` from `at`. Traps when exceptions are unavailable
+     */
+    struct inplace_vector_errors {
+        static constexpr bool CHECKED = true;
+        [[noreturn]] static void fail(fixed_vector_error err, const char* what, size_t a, size_t b) {
+#if FIXED_VECTOR_EXCEPTIONS
+            if (err != fixed_vector_error::out_of_range) fixed_vector_detail::throw_bad_alloc();
+            fixed_vector_detail::throw_error(err, what, a, b);
+#else
+            trap_on_error::fail(err, what, a, b);
+#endif
+        }
+    };
+}
+
+/**
+ * @class inplace_vector
+ * @brief The C++26 `std::inplace_vector<T, N>` interface (P0843) over this library's storage, for C++20
+ *
+ * Unlike `fixed_vector`, the interface is exactly the standard one, so code can move between this and
+ * `std::inplace_vector` by changing the name: positions are iterators, `pop_back` returns nothing, `operator[]` does not
+ * check, and running out of capacity throws `std::bad_alloc`. The `try_` members report failure through their return
+ * value and the `unchecked_` members have it as a precondition.
+ *
+ * Copying, moving and destroying are trivial whenever they are for `T`, so the vector is trivially copyable when `T` is.
+ * Differences from the standard: `inplace_vector<T, 0>` is not an empty type, and the `std::from_range_t` constructor
+ * only exists when the standard library provides `std::from_range_t`
+ * @tparam T The element type
+ * @tparam N The compile-time capacity
+ */
+template <typename T, size_t N>
+class inplace_vector : private fixed_vector_base<T> {
+    using base = fixed_vector_base<T>;
+    using Policy = fixed_vector_policy::inplace_vector_errors;
+
+    /// @brief A range whose elements can be converted to `T`
+    template <typename R>
+    static constexpr bool COMPATIBLE_RANGE =
+        std::ranges::input_range<R> && std::convertible_to<std::ranges::range_reference_t<R>, T>;
+
+    /// @brief Whether assigning a vector can be a plain copy of its bytes
+    static constexpr bool TRIVIAL_COPY_ASSIGN = std::is_trivially_copy_constructible_v<T> &&
+        std::is_trivially_copy_assignable_v<T> && std::is_trivially_destructible_v<T>;
+    static constexpr bool TRIVIAL_MOVE_ASSIGN = std::is_trivially_move_constructible_v<T> &&
+        std::is_trivially_move_assignable_v<T> && std::is_trivially_destructible_v<T>;
+
+public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    /// @brief The current logical size, in the smallest type that can hold `N`
+    fixed_vector_detail::smallest_size_t<N> _current_size;
+    /// @brief Uninitialized storage for the elements. Only the first `_current_size` slots contain live objects
+    fixed_vector_detail::storage<T, (N > 0 ? N : 1)> _buf;
+
+    constexpr T* slot(size_t pos) noexcept { return this->_buf.data() + pos; }
+    constexpr const T* slot(size_t pos) const noexcept { return this->_buf.data() + pos; }
+
+    /// @brief Fail unless `n` elements fit in the capacity
+    static constexpr void check_fits(size_t n) {
+        fixed_vector_detail::check<Policy>(n > N, fixed_vector_error::too_many, "Cannot grow", n, N);
+    }
+
+    /// @brief Destroy the live objects in `[first, _current_size)` and shrink the logical size to `first`
+    constexpr void destroy_from(size_t first) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            if (first != this->_current_size) base::destroy_n(this->slot(first), this->_current_size - first);
+        }
+        this->_current_size = static_cast<decltype(this->_current_size)>(first);
+    }
+
+    /// @brief Construct a value at the end without checking capacity
+    template <typename... Args>
+    constexpr T& construct_back(Args&&... args) {
+        const size_t size = this->_current_size;
+        T* elem = std::construct_at(this->slot(size), std::forward<Args>(args)...);
+        this->_current_size = static_cast<decltype(this->_current_size)>(size + 1);
+        return *elem;
+    }
+
+    /**
+     * @brief Append elements of `[first, last)` until the range or the capacity runs out
+     *
+     * The size is updated after every element, so if a constructor throws the elements appended so far stay
+     * @return An iterator to the first element that was not appended
+     */
+    template <typename It, typename S>
+    constexpr It append_until_full(It first, S last) {
+        for (; first != last && this->_current_size != N; ++first) this->construct_back(*first);
+        return first;
+    }
+
+    /// @brief Append every element of `[first, last)`, checking the capacity once up front when the length is known
+    template <typename It, typename S>
+    constexpr void append(It first, S last) {
+        if constexpr (std::sized_sentinel_for<S, It>) {
+            check_fits(this->_current_size + static_cast<size_t>(last - first));
+        }
+        first = this->append_until_full(std::move(first), last);
+        fixed_vector_detail::check<Policy>(first != last, fixed_vector_error::full, "Cannot append", N);
+    }
+
+    /// @brief Run `append`, and if it throws, destroy whatever it appended past `old_size` before rethrowing
+    template <typename F>
+    constexpr void append_or_roll_back(size_t old_size, F append) {
+#if FIXED_VECTOR_EXCEPTIONS
+        try {
+            append();
+        } catch (...) {
+            this->destroy_from(old_size);
+            throw;
+        }
+#else
+        (void)old_size;
+        append();
+#endif
+    }
+
+    /**
+     * @brief Insert `[first, last)` before index `off`
+     *
+     * When the length is known and constructing cannot throw, the tail is shifted once and the elements are
+     * constructed into the gap. Otherwise they are appended and rotated into place, which leaves the vector unchanged
+     * if a constructor throws
+     */
+    template <typename It, typename S>
+    constexpr iterator insert_at(size_t off, It first, S last) {
+        const size_t old_size = this->_current_size;
+        if constexpr (std::forward_iterator<It> && std::is_nothrow_constructible_v<T, std::iter_reference_t<It>>) {
+            const size_t n = static_cast<size_t>(std::ranges::distance(first, last));
+            check_fits(old_size + n);
+            base::open_gap(this->slot(0), old_size, off, n);
+            for (T* dst = this->slot(off); first != last; ++first, ++dst) std::construct_at(dst, *first);
+            this->_current_size = static_cast<decltype(this->_current_size)>(old_size + n);
+        } else {
+            if constexpr (std::sized_sentinel_for<S, It>) check_fits(old_size + static_cast<size_t>(last - first));
+            this->append_or_roll_back(old_size, [&] { first = this->append_until_full(std::move(first), last); });
+            if (first != last) [[unlikely]] {
+                this->destroy_from(old_size);
+                Policy::fail(fixed_vector_error::full, "Cannot insert", N, 0);
+            }
+            std::rotate(this->slot(off), this->slot(old_size), this->slot(this->_current_size));
+        }
+        return this->slot(off);
+    }
+
+public:
+    /// @brief Default constructor. Initial size will be 0 and no element is constructed
+    constexpr inplace_vector() noexcept : _current_size(0) {}
+
+    /*
+     * A throwing constructor never runs the destructor, so the constructors below destroy the elements they have
+     * already built before letting an exception out
+     */
+
+    /// @brief Construct `n` value-initialized elements
+    constexpr explicit inplace_vector(size_type n) : _current_size(0) {
+        this->append_or_roll_back(0, [&] { this->resize(n); });
+    }
+
+    /// @brief Construct `n` copies of `val`
+    constexpr inplace_vector(size_type n, const T& val) : _current_size(0) {
+        this->append_or_roll_back(0, [&] { this->assign(n, val); });
+    }
+
+    /// @brief Construct a copy of the elements of `[first, last)`
+    template <std::input_iterator It>
+    constexpr inplace_vector(It first, It last) : _current_size(0) {
+        this->append_or_roll_back(0, [&] { this->append(std::move(first), last); });
+    }
+
+#ifdef __cpp_lib_containers_ranges
+    /// @brief Construct a copy of the elements of `range`
+    template <typename R> requires COMPATIBLE_RANGE<R>
+    constexpr inplace_vector(std::from_range_t, R&& range) : _current_size(0) {
+        this->append_or_roll_back(0, [&] { this->append_range(std::forward<R>(range)); });
+    }
+#endif
+
+    /// @brief Initializer list constructor
+    constexpr inplace_vector(std::initializer_list<T> init_list) : _current_size(0) {
+        this->append_or_roll_back(0, [&] { this->append(init_list.begin(), init_list.end()); });
+    }
+
+    /// @brief Copy constructor, trivial when the copy constructor of `T` is
+    constexpr inplace_vector(const inplace_vector&) requires std::is_trivially_copy_constructible_v<T> = default;
+
+    /// @brief Copy constructor
+    constexpr inplace_vector(const inplace_vector& v) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        requires (std::is_copy_constructible_v<T> && !std::is_trivially_copy_constructible_v<T>)
+        : _current_size(0)
+    {
+        fixed_vector_detail::copy_construct_n(v.slot(0), v._current_size, this->slot(0));
+        this->_current_size = v._current_size;
+    }
+
+    /// @brief Move constructor, trivial when the move constructor of `T` is
+    constexpr inplace_vector(inplace_vector&&) requires std::is_trivially_move_constructible_v<T> = default;
+
+    /// @brief Move constructor. The elements of `v` are left in a moved-from state
+    constexpr inplace_vector(inplace_vector&& v) noexcept(std::is_nothrow_move_constructible_v<T>)
+        requires (std::is_move_constructible_v<T> && !std::is_trivially_move_constructible_v<T>)
+        : _current_size(0)
+    {
+        fixed_vector_detail::move_construct_n(v.slot(0), v._current_size, this->slot(0));
+        this->_current_size = v._current_size;
+    }
+
+    /// @brief Destructor, trivial when the destructor of `T` is
+    constexpr ~inplace_vector() requires std::is_trivially_destructible_v<T> = default;
+
+    /// @brief Destructor: destroys every live element
+    constexpr ~inplace_vector() { this->destroy_from(0); }
+
+    /// @brief Copy assignment, trivial when copying and destroying `T` are
+    constexpr inplace_vector& operator= (const inplace_vector&) requires TRIVIAL_COPY_ASSIGN = default;
+
+    /// @brief Copy assignment
+    constexpr inplace_vector& operator= (const inplace_vector& v)
+        requires (std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T> && !TRIVIAL_COPY_ASSIGN)
+    {
+        if (this == &v) return *this;
+        base::template assign<false>(this->slot(0), this->_current_size, v.slot(0), v._current_size);
+        this->_current_size = v._current_size;
+        return *this;
+    }
+
+    /// @brief Move assignment, trivial when moving and destroying `T` are
+    constexpr inplace_vector& operator= (inplace_vector&&) requires TRIVIAL_MOVE_ASSIGN = default;
+
+    /// @brief Move assignment. The elements of `v` are left in a moved-from state
+    constexpr inplace_vector& operator= (inplace_vector&& v)
+        noexcept(std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_constructible_v<T>)
+        requires (std::is_move_constructible_v<T> && std::is_move_assignable_v<T> && !TRIVIAL_MOVE_ASSIGN)
+    {
+        if (this == &v) return *this;
+        base::template assign<true>(this->slot(0), this->_current_size, v.slot(0), v._current_size);
+        this->_current_size = v._current_size;
+        return *this;
+    }
+
+    /// @brief Replace the contents with the elements of an initializer list
+    constexpr inplace_vector& operator= (std::initializer_list<T> init_list) {
+        this->assign(init_list);
+        return *this;
+    }
+
+    /// @brief Replace the contents with the elements of `[first, last)`
+    template <std::input_iterator It>
+    constexpr void assign(It first, It last) {
+        if constexpr (std::forward_iterator<It>) check_fits(static_cast<size_t>(std::distance(first, last)));
+        this->clear();
+        this->append(first, last);
+    }
+
+    /// @brief Replace the contents with the elements of `range`
+    template <typename R> requires COMPATIBLE_RANGE<R>
+    constexpr void assign_range(R&& range) {
+        if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>)
+            check_fits(static_cast<size_t>(std::ranges::distance(range)));
+        this->clear();
+        this->append(std::ranges::begin(range), std::ranges::end(range));
+    }
+
+    /// @brief Replace the contents with `n` copies of `val`
+    constexpr void assign(size_type n, const T& val) {
+        check_fits(n);
+        // Copy first: `val` may be one of the elements about to be destroyed
+        T copy(val);
+        this->clear();
+        for (size_t i = 0; i < n; ++i) this->construct_back(copy);
+    }
+
+    /// @brief Replace the contents with the elements of an initializer list
+    constexpr void assign(std::initializer_list<T> init_list) { this->assign(init_list.begin(), init_list.end()); }
+
+    /// @brief Get mutable iterator to beginning
+    constexpr iterator begin() noexcept { return this->slot(0); }
+
+    /// @brief Get const iterator to beginning
+    constexpr const_iterator begin() const noexcept { return this->slot(0); }
+
+    /// @brief Get mutable iterator to end
+    constexpr iterator end() noexcept { return this->slot(this->_current_size); }
+
+    /// @brief Get const iterator to end
+    constexpr const_iterator end() const noexcept { return this->slot(this->_current_size); }
+
+    /// @brief Get mutable reverse iterator to the last element
+    constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(this->end()); }
+
+    /// @brief Get const reverse iterator to the last element
+    constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(this->end()); }
+
+    /// @brief Get mutable reverse iterator to before the first element
+    constexpr reverse_iterator rend() noexcept { return reverse_iterator(this->begin()); }
+
+    /// @brief Get const reverse iterator to before the first element
+    constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(this->begin()); }
+
+    /// @brief Get const iterator to beginning
+    constexpr const_iterator cbegin() const noexcept { return this->begin(); }
+
+    /// @brief Get const iterator to end
+    constexpr const_iterator cend() const noexcept { return this->end(); }
+
+    /// @brief Get const reverse iterator to the last element
+    constexpr const_reverse_iterator crbegin() const noexcept { return this->rbegin(); }
+
+    /// @brief Get const reverse iterator to before the first element
+    constexpr const_reverse_iterator crend() const noexcept { return this->rend(); }
+
+    /// @brief Whether the vector holds no elements
+    [[nodiscard]] constexpr bool empty() const noexcept { return this->_current_size == 0; }
+
+    /// @brief Get the current logical size
+    constexpr size_type size() const noexcept { return this->_current_size; }
+
+    /// @brief Get the capacity
+    static constexpr size_type max_size() noexcept { return N; }
+
+    /// @brief Get the capacity
+    static constexpr size_type capacity() noexcept { return N; }
+
+    /// @brief Resize to `n` elements, value-initializing new ones
+    constexpr void resize(size_type n) {
+        check_fits(n);
+        if (n <= this->_current_size) this->destroy_from(n);
+        else while (this->_current_size != n) this->construct_back();
+    }
+
+    /// @brief Resize to `n` elements, copying `val` into new ones
+    constexpr void resize(size_type n, const T& val) {
+        check_fits(n);
+        if (n <= this->_current_size) this->destroy_from(n);
+        else while (this->_current_size != n) this->construct_back(val);
+    }
+
+    /// @brief Does nothing, or fails with `std::bad_alloc` if `n` exceeds the capacity
+    static constexpr void reserve(size_type n) { check_fits(n); }
+
+    /// @brief Does nothing
+    static constexpr void shrink_to_fit() noexcept {}
+
+    /// @brief Get the element at `pos`
+    /// @warning DOES NOT BOUNDS CHECK
+    constexpr reference operator[](size_type pos) { return *this->slot(pos); }
+
+    /// @brief Get the element at `pos`
+    /// @warning DOES NOT BOUNDS CHECK
+    constexpr const_reference operator[](size_type pos) const { return *this->slot(pos); }
+
+    /// @brief Get the element at `pos`, failing with `std::out_of_range` if there is none
+    constexpr reference at(size_type pos) {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->_current_size);
+        return *this->slot(pos);
+    }
+
+    /// @brief Get the element at `pos`, failing with `std::out_of_range` if there is none
+    constexpr const_reference at(size_type pos) const {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->_current_size);
+        return *this->slot(pos);
+    }
+
+    /// @brief Get the first element. The vector must not be empty
+    constexpr reference front() { return *this->slot(0); }
+
+    /// @brief Get the first element. The vector must not be empty
+    constexpr const_reference front() const { return *this->slot(0); }
+
+    /// @brief Get the last element. The vector must not be empty
+    constexpr reference back() { return *this->slot(this->_current_size - 1); }
+
+    /// @brief Get the last element. The vector must not be empty
+    constexpr const_reference back() const { return *this->slot(this->_current_size - 1); }
+
+    /// @brief Get a pointer to the underlying storage
+    constexpr T* data() noexcept { return this->slot(0); }
+
+    /// @brief Get a const pointer to the underlying storage
+    constexpr const T* data() const noexcept { return this->slot(0); }
+
+    /// @brief Construct a value in place at the end, failing with `std::bad_alloc` if the vector is full
+    template <typename... Args>
+    constexpr reference emplace_back(Args&&... args) {
+        fixed_vector_detail::check<Policy>(this->_current_size == N, fixed_vector_error::full, "Cannot push back", N);
+        return this->construct_back(std::forward<Args>(args)...);
+    }
+
+    /// @brief Copy a value to the end, failing with `std::bad_alloc` if the vector is full
+    constexpr reference push_back(const T& val) { return this->emplace_back(val); }
+
+    /// @brief Move a value to the end, failing with `std::bad_alloc` if the vector is full
+    constexpr reference push_back(T&& val) { return this->emplace_back(std::move(val)); }
+
+    /**
+     * @brief Append the elements of `range`, failing with `std::bad_alloc` if they do not all fit
+     *
+     * The capacity is checked once up front for sized ranges. For other ranges, the elements that fit are appended
+     * before failing
+     */
+    template <typename R> requires COMPATIBLE_RANGE<R>
+    constexpr void append_range(R&& range) {
+        if constexpr (std::ranges::sized_range<R>) check_fits(this->_current_size + std::ranges::size(range));
+        this->append(std::ranges::begin(range), std::ranges::end(range));
+    }
+
+    /// @brief Remove the last element. The vector must not be empty
+    constexpr void pop_back() { this->destroy_from(this->_current_size - 1u); }
+
+    /// @brief Construct a value in place at the end if there is room
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    template <typename... Args>
+    constexpr pointer try_emplace_back(Args&&... args) {
+        if (this->_current_size == N) [[unlikely]] return nullptr;
+        return &this->construct_back(std::forward<Args>(args)...);
+    }
+
+    /// @brief Copy a value to the end if there is room
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    constexpr pointer try_push_back(const T& val) { return this->try_emplace_back(val); }
+
+    /// @brief Move a value to the end if there is room. `val` is untouched if there is not
+    /// @return A pointer to the new element, or `nullptr` if the vector was full
+    constexpr pointer try_push_back(T&& val) { return this->try_emplace_back(std::move(val)); }
+
+    /// @brief Append as many elements of `range` as fit
+    /// @return An iterator to the first element of `range` that was not appended
+    template <typename R> requires COMPATIBLE_RANGE<R>
+    constexpr std::ranges::borrowed_iterator_t<R> try_append_range(R&& range) {
+        return this->append_until_full(std::ranges::begin(range), std::ranges::end(range));
+    }
+
+    /// @brief Construct a value in place at the end without checking capacity
+    /// @warning DOES NOT BOUNDS CHECK: the vector must not be full
+    template <typename... Args>
+    constexpr reference unchecked_emplace_back(Args&&... args) {
+        return this->construct_back(std::forward<Args>(args)...);
+    }
+
+    /// @brief Copy a value to the end without checking capacity
+    /// @warning DOES NOT BOUNDS CHECK: the vector must not be full
+    constexpr reference unchecked_push_back(const T& val) { return this->construct_back(val); }
+
+    /// @brief Move a value to the end without checking capacity
+    /// @warning DOES NOT BOUNDS CHECK: the vector must not be full
+    constexpr reference unchecked_push_back(T&& val) { return this->construct_back(std::move(val)); }
+
+    /// @brief Construct a value in place before `pos`, failing with `std::bad_alloc` if the vector is full
+    /// @return An iterator to the new element
+    template <typename... Args>
+    constexpr iterator emplace(const_iterator pos, Args&&... args) {
+        fixed_vector_detail::check<Policy>(this->_current_size == N, fixed_vector_error::full, "Cannot insert", N);
+        const size_t off = static_cast<size_t>(pos - this->begin());
+        if (off == this->_current_size) return &this->construct_back(std::forward<Args>(args)...);
+        // Build the value before shifting: the arguments may refer to elements of this vector
+        T val(std::forward<Args>(args)...);
+        T& elem = base::insert_at(this->slot(0), this->_current_size, off, std::move(val));
+        ++this->_current_size;
+        return &elem;
+    }
+
+    /// @brief Copy a value before `pos`, failing with `std::bad_alloc` if the vector is full
+    constexpr iterator insert(const_iterator pos, const T& val) { return this->emplace(pos, val); }
+
+    /// @brief Move a value before `pos`, failing with `std::bad_alloc` if the vector is full
+    constexpr iterator insert(const_iterator pos, T&& val) { return this->emplace(pos, std::move(val)); }
+
+    /// @brief Insert `n` copies of `val` before `pos`, failing with `std::bad_alloc` if they do not fit
+    /// @return An iterator to the first inserted element
+    constexpr iterator insert(const_iterator pos, size_type n, const T& val) {
+        const size_t off = static_cast<size_t>(pos - this->begin());
+        const size_t old_size = this->_current_size;
+        check_fits(old_size + n);
+        if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+            // Copy first: `val` may be one of the elements about to be shifted
+            const T copy(val);
+            base::open_gap(this->slot(0), old_size, off, n);
+            for (size_t i = 0; i < n; ++i) std::construct_at(this->slot(off + i), copy);
+            this->_current_size = static_cast<decltype(this->_current_size)>(old_size + n);
+        } else {
+            // Appending leaves every element, and so `val`, where it is
+            this->append_or_roll_back(old_size, [&] { for (size_t i = 0; i < n; ++i) this->construct_back(val); });
+            std::rotate(this->slot(off), this->slot(old_size), this->slot(this->_current_size));
+        }
+        return this->slot(off);
+    }
+
+    /// @brief Insert the elements of `[first, last)` before `pos`, failing with `std::bad_alloc` if they do not fit
+    /// @return An iterator to the first inserted element
+    template <std::input_iterator It>
+    constexpr iterator insert(const_iterator pos, It first, It last) {
+        return this->insert_at(static_cast<size_t>(pos - this->begin()), std::move(first), std::move(last));
+    }
+
+    /// @brief Insert the elements of `range` before `pos`, failing with `std::bad_alloc` if they do not fit
+    /// @return An iterator to the first inserted element
+    template <typename R> requires COMPATIBLE_RANGE<R>
+    constexpr iterator insert_range(const_iterator pos, R&& range) {
+        return this->insert_at(static_cast<size_t>(pos - this->begin()), std::ranges::begin(range),
+                               std::ranges::end(range));
+    }
+
+    /// @brief Insert the elements of an initializer list before `pos`
+    /// @return An iterator to the first inserted element
+    constexpr iterator insert(const_iterator pos, std::initializer_list<T> init_list) {
+        return this->insert(pos, init_list.begin(), init_list.end());
+    }
+
+    /// @brief Destroy the element at `pos`, shifting every later element to the left
+    /// @return An iterator to the element after the erased one
+    constexpr iterator erase(const_iterator pos) { return this->erase(pos, pos + 1); }
+
+    /// @brief Destroy the elements of `[first, last)`, shifting every later element to the left
+    /// @return An iterator to the element after the erased ones
+    constexpr iterator erase(const_iterator first, const_iterator last) {
+        const size_t off = static_cast<size_t>(first - this->begin());
+        const size_t count = static_cast<size_t>(last - first);
+        if (count != 0) {
+            base::erase_at(this->slot(0), this->_current_size, off, count);
+            this->_current_size = static_cast<decltype(this->_current_size)>(this->_current_size - count);
+        }
+        return this->slot(off);
+    }
+
+    /// @brief Swap the contents of two vectors, touching only their live elements
+    constexpr void swap(inplace_vector& v)
+        noexcept(N == 0 || (std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>))
+    {
+        if (this == &v) return;
+        base::swap_ranges(this->slot(0), this->_current_size, v.slot(0), v._current_size);
+        std::swap(this->_current_size, v._current_size);
+    }
+
+    /// @brief Destroy every element
+    constexpr void clear() noexcept { this->destroy_from(0); }
+
+    /// @brief Swap the contents of two vectors
+    friend constexpr void swap(inplace_vector& a, inplace_vector& b) noexcept(noexcept(a.swap(b))) { a.swap(b); }
+
+    /// @brief Whether two vectors hold equal elements
+    friend constexpr bool operator== (const inplace_vector& a, const inplace_vector& b) {
+        return a._current_size == b._current_size && base::equal(a.slot(0), b.slot(0), a._current_size);
+    }
+
+    /// @brief Compare two vectors lexicographically
+    friend constexpr auto operator<=> (const inplace_vector& a, const inplace_vector& b)
+        requires requires(const T& t) { t < t; }
+    {
+        return std::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end(),
+                                                      fixed_vector_detail::synth_three_way{});
+    }
+};
+
+/// @brief Erase every element equal to `val`
+/// @return The number of elements erased
+template <typename T, size_t N, typename U = T>
+constexpr size_t erase(inplace_vector<T, N>& v, const U& val) {
+    auto it = std::remove(v.begin(), v.end(), val);
+    const auto n = static_cast<size_t>(v.end() - it);
+    v.erase(it, v.end());
+    return n;
+}
+
+/// @brief Erase every element satisfying `pred`
+/// @return The number of elements erased
+template <typename T, size_t N, typename Pred>
+constexpr size_t erase_if(inplace_vector<T, N>& v, Pred pred) {
+    auto it = std::remove_if(v.begin(), v.end(), pred);
+    const auto n = static_cast<size_t>(v.end() - it);
+    v.erase(it, v.end());
+    return n;
+}
+
+#endif //INPLACE_VECTOR_HPP
@@ -0,0 +1,437 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include "fixed_vector.hpp"
+
+#include <atomic>
+
+/**
+ * @class small_vector
+ * @brief Like `fixed_vector<T, CAPACITY>` while it fits, but moves to an allocated buffer instead of failing when full
+ *
+ * The first `CAPACITY` elements live in inline storage, so the common case never allocates. Growing past that moves
+ * every element into a buffer from `Allocator` (doubling on each further growth) and counts a spill event, so
+ * `CAPACITY` can be chosen for the median case while outliers stay correct
+ * @tparam T The data type to store in the small vector
+ * @tparam CAPACITY The number of elements held inline before spilling
+ * @tparam Policy What to do when a check fails, one of the `fixed_vector_policy` types
+ * @tparam Allocator The allocator used once the inline storage is exhausted
+ */
+template <typename T, size_t CAPACITY, typename Policy = fixed_vector_policy::default_policy,
+          typename Allocator = std::allocator<T>>
+class small_vector {
+    static_assert(CAPACITY > 0, "Capacity cannot be 0");
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+public:
+    using size_type = size_t;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = Allocator;
+    /// @brief Mutable iterator type: plain pointers, as in `fixed_vector`
+    using iterator = T*;
+    /// @brief Const iterator type
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    /// @brief Uninitialized inline storage, used until the first spill
+    fixed_vector_detail::storage<T, CAPACITY> _inline;
+    /// @brief The elements: either the inline storage or an allocated buffer
+    T* _data;
+    /// @brief The current logical size of the small vector
+    size_t _current_size;
+    /// @brief The number of slots `_data` points to: `CAPACITY` while inline
+    size_t _capacity;
+    /// @brief The allocator used for spilled buffers
+    [[no_unique_address]] Allocator _alloc;
+
+    /// @brief The number of times any `small_vector` of this type left its inline storage
+    static inline std::atomic<size_t> _spills{0};
+
+    /// @brief Get a pointer to the storage slot at `pos`, which may or may not hold a live object
+    T* slot(size_t pos) noexcept { return this->_data + pos; }
+
+    /// @brief Get a const pointer to the storage slot at `pos`, which may or may not hold a live object
+    const T* slot(size_t pos) const noexcept { return this->_data + pos; }
+
+    /// @brief Destroy the live objects in `[first, _current_size)` and shrink the logical size to `first`
+    void destroy_from(size_t first) noexcept {
+        std::destroy(this->slot(first), this->slot(this->_current_size));
+        this->_current_size = first;
+    }
+
+    /// @brief Destroy every element and return any allocated buffer, going back to the inline storage
+    void release() noexcept {
+        this->destroy_from(0);
+        if (!this->is_inline()) alloc_traits::deallocate(this->_alloc, this->_data, this->_capacity);
+        this->_data = this->_inline.data();
+        this->_capacity = CAPACITY;
+    }
+
+    /// @brief Run `f`, and if it throws, release everything before rethrowing. For constructors, whose failure never
+    /// reaches the destructor
+    template <typename F>
+    void release_on_throw(F f) {
+#if FIXED_VECTOR_EXCEPTIONS
+        try {
+            f();
+        } catch (...) {
+            this->release();
+            throw;
+        }
+#else
+        f();
+#endif
+    }
+
+    /// @brief Get the capacity to grow to so that at least `needed` elements fit
+    size_t grown_capacity(size_t needed) const noexcept { return std::max(needed, this->_capacity * 2); }
+
+    /**
+     * @brief Move every element into a freshly allocated buffer of `new_capacity` slots, after `pre` has run on it
+     *
+     * If `pre` or a move throws, the new buffer is released and the vector is left as it was
+     * @param pre Called with the new buffer before the old elements are moved, e.g. to construct a new element.
+     * Returns the object it constructed, or `nullptr`
+     */
+    template <typename F>
+    [[gnu::noinline]] void relocate(size_t new_capacity, F&& pre) {
+        T* buf = alloc_traits::allocate(this->_alloc, new_capacity);
+#if FIXED_VECTOR_EXCEPTIONS
+        T* made = nullptr;
+        try {
+            made = pre(buf);
+            fixed_vector_detail::move_construct_n(this->_data, this->_current_size, buf);
+        } catch (...) {
+            if (made != nullptr) std::destroy_at(made);
+            alloc_traits::deallocate(this->_alloc, buf, new_capacity);
+            throw;
+        }
+#else
+        pre(buf);
+        fixed_vector_detail::move_construct_n(this->_data, this->_current_size, buf);
+#endif
+        std::destroy(this->_data, this->_data + this->_current_size);
+        if (this->is_inline()) _spills.fetch_add(1, std::memory_order_relaxed);
+        else alloc_traits::deallocate(this->_alloc, this->_data, this->_capacity);
+        this->_data = buf;
+        this->_capacity = new_capacity;
+    }
+
+    /**
+     * @fn unsafe_right_shift
+     * @brief Blindly open a gap of `count` raw slots at `pos`, shifting everything after it to the right
+     * @warning DOES NOT BOUNDS CHECK: there must be room for `count` more elements
+     */
+    void unsafe_right_shift(size_t pos, size_t count) {
+        fixed_vector_detail::shift_right(this->_data, this->_current_size, pos, count);
+        this->_current_size += count;
+    }
+
+    /**
+     * @fn unsafe_left_shift
+     * @brief Blindly destroy `count` elements at `pos`, shifting everything after them to the left
+     * @warning DOES NOT BOUNDS CHECK
+     */
+    void unsafe_left_shift(size_t pos, size_t count) {
+        fixed_vector_detail::shift_left(this->_data, this->_current_size, pos, count);
+        this->_current_size -= count;
+    }
+
+    /// @brief Take over the elements of `v`, stealing its buffer if it has spilled
+    void steal(small_vector& v) {
+        if (v.is_inline()) {
+            fixed_vector_detail::move_construct_n(v._data, v._current_size, this->_data);
+            this->_current_size = v._current_size;
+            v.destroy_from(0);
+        } else {
+            this->_data = v._data;
+            this->_current_size = v._current_size;
+            this->_capacity = v._capacity;
+            v._data = v._inline.data();
+            v._current_size = 0;
+            v._capacity = CAPACITY;
+        }
+    }
+
+public:
+    /// @brief Default constructor. Initial size will be 0 and nothing is allocated
+    small_vector()
+        : _data(nullptr),
+          _current_size(0),
+          _capacity(CAPACITY),
+          _alloc()
+    {
+        this->_data = this->_inline.data();
+    }
+
+    /// @brief Construct an empty small vector that will spill into buffers from `alloc`
+    explicit small_vector(const Allocator& alloc)
+        : _data(nullptr),
+          _current_size(0),
+          _capacity(CAPACITY),
+          _alloc(alloc)
+    {
+        this->_data = this->_inline.data();
+    }
+
+    /// @brief Copy constructor. Allocates only if `v` holds more than `CAPACITY` elements
+    small_vector(const small_vector& v) requires std::is_copy_constructible_v<T>
+        : _data(nullptr),
+          _current_size(0),
+          _capacity(CAPACITY),
+          _alloc(alloc_traits::select_on_container_copy_construction(v._alloc))
+    {
+        this->_data = this->_inline.data();
+        this->release_on_throw([&] {
+            this->reserve(v._current_size);
+            fixed_vector_detail::copy_construct_n(v._data, v._current_size, this->_data);
+            this->_current_size = v._current_size;
+        });
+    }
+
+    /// @brief Move constructor. A spilled buffer is taken over, inline elements are moved one by one
+    small_vector(small_vector&& v) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : _data(nullptr),
+          _current_size(0),
+          _capacity(CAPACITY),
+          _alloc(std::move(v._alloc))
+    {
+        this->_data = this->_inline.data();
+        this->steal(v);
+    }
+
+    /// @brief Initializer list constructor: allows initialization of `small_vector` using curly brace lists
+    small_vector(std::initializer_list<T> init_list)
+        : small_vector()
+    {
+        this->release_on_throw([&] {
+            this->reserve(init_list.size());
+            fixed_vector_detail::copy_construct_n(init_list.begin(), init_list.size(), this->_data);
+            this->_current_size = init_list.size();
+        });
+    }
+
+    /// @brief Destructor: destroys every live element and returns any allocated buffer
+    ~small_vector() { this->release(); }
+
+    /// @brief Allow another `small_vector` to be copied into this one using the `=` operator
+    small_vector& operator= (const small_vector& v) requires std::is_copy_constructible_v<T> {
+        if (this == &v) return *this;
+        this->destroy_from(0);
+        this->reserve(v._current_size);
+        fixed_vector_detail::copy_construct_n(v._data, v._current_size, this->_data);
+        this->_current_size = v._current_size;
+        return *this;
+    }
+
+    /// @brief Allow another `small_vector` to be moved into this one using the `=` operator
+    small_vector& operator= (small_vector&& v) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                        alloc_traits::is_always_equal::value) {
+        if (this == &v) return *this;
+        if (v.is_inline() || alloc_traits::is_always_equal::value ||
+            alloc_traits::propagate_on_container_move_assignment::value || this->_alloc == v._alloc) {
+            this->release();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) this->_alloc = std::move(v._alloc);
+            this->steal(v);
+        } else {
+            // Unequal allocators that do not propagate: the buffer cannot change hands
+            this->destroy_from(0);
+            this->reserve(v._current_size);
+            fixed_vector_detail::move_construct_n(v._data, v._current_size, this->_data);
+            this->_current_size = v._current_size;
+            v.destroy_from(0);
+        }
+        return *this;
+    }
+
+    /// @brief Swap the contents of two `small_vector`s
+    void swap(small_vector& v) {
+        small_vector tmp(std::move(v));
+        v = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    /// @brief Swap the contents of two `small_vector`s
+    friend void swap(small_vector& a, small_vector& b) { a.swap(b); }
+
+    /// @brief Get the number of elements held inline before spilling
+    [[nodiscard]] static constexpr size_t inline_capacity() noexcept { return CAPACITY; }
+
+    /// @brief Get the number of elements that fit without allocating again
+    [[nodiscard]] size_t capacity() const { return this->_capacity; }
+
+    /// @brief Get the small vector current logical size
+    [[nodiscard]] size_t size() const { return this->_current_size; }
+
+    /// @brief Whether the elements still live in the inline storage
+    [[nodiscard]] bool is_inline() const { return this->_data == this->_inline.data(); }
+
+    /// @brief Get the number of times any `small_vector` of this type has spilled out of its inline storage
+    [[nodiscard]] static size_t spill_count() noexcept { return _spills.load(std::memory_order_relaxed); }
+
+    /// @brief Reset the spill counter of this type to 0
+    static void reset_spill_count() noexcept { _spills.store(0, std::memory_order_relaxed); }
+
+    /// @brief Get the allocator used for spilled buffers
+    [[nodiscard]] allocator_type get_allocator() const { return this->_alloc; }
+
+    /// @brief Make room for at least `n` elements, spilling if `n` exceeds the current capacity
+    void reserve(size_t n) {
+        if (n > this->_capacity) this->relocate(n, [](T*) -> T* { return nullptr; });
+    }
+
+    /// @brief Clear the small vector logical contents, destroying every element but keeping any allocated buffer
+    void clear() { this->destroy_from(0); }
+
+    /// @brief Get a pointer to the elements
+    [[nodiscard]] T* data() { return this->_data; }
+
+    /// @brief Get a const pointer to the elements
+    [[nodiscard]] const T* data() const { return this->_data; }
+
+    /// @brief Get a const pointer to the elements
+    [[nodiscard]] const T* cdata() const { return this->_data; }
+
+    /// @brief Construct a value in place at the end, spilling to an allocated buffer if full
+    /// @return A reference to the new element
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        const size_t size = this->_current_size;
+        if (size == this->_capacity) [[unlikely]] {
+            // Construct the new element before moving the old ones: `args` may refer to one of them
+            this->relocate(this->grown_capacity(size + 1), [&](T* buf) {
+                return std::construct_at(buf + size, std::forward<Args>(args)...);
+            });
+        } else {
+            std::construct_at(this->slot(size), std::forward<Args>(args)...);
+        }
+        this->_current_size = size + 1;
+        return *this->slot(size);
+    }
+
+    /// @brief Construct a value in place at index `pos`, shifting every later value to the right
+    /// @param pos The index the new element will have. Must not be larger than `size()`
+    /// @return A reference to the new element
+    template <typename... Args>
+    T& emplace(size_t pos, Args&&... args) {
+        fixed_vector_detail::check<Policy>(pos > this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot insert", pos, this->_current_size);
+        if (pos == this->_current_size) return this->emplace_back(std::forward<Args>(args)...);
+        // Build the value first: the arguments may refer to elements that are about to move
+        T val(std::forward<Args>(args)...);
+        if (this->_current_size == this->_capacity) [[unlikely]]
+            this->relocate(this->grown_capacity(this->_current_size + 1), [](T*) -> T* { return nullptr; });
+        this->unsafe_right_shift(pos, 1);
+        return *std::construct_at(this->slot(pos), std::move(val));
+    }
+
+    /// @brief Construct a value in place at the front, increasing the logical size by 1
+    /// @warning Shifts every value to the right: could be costly for large vectors
+    template <typename... Args>
+    T& emplace_front(Args&&... args) { return this->emplace(0, std::forward<Args>(args)...); }
+
+    /// @brief Copy a value to the end, spilling to an allocated buffer if full
+    void push_back(const T& val) { this->emplace_back(val); }
+
+    /// @brief Move a value to the end, spilling to an allocated buffer if full
+    void push_back(T&& val) { this->emplace_back(std::move(val)); }
+
+    /// @brief Copy a value to the front, spilling to an allocated buffer if full
+    /// @warning Shifts every value to the right: could be costly for large vectors
+    void push_front(const T& val) { this->emplace(0, val); }
+
+    /// @brief Move a value to the front, spilling to an allocated buffer if full
+    /// @warning Shifts every value to the right: could be costly for large vectors
+    void push_front(T&& val) { this->emplace(0, std::move(val)); }
+
+    /// @brief Remove a value from the end of the small vector, decreasing the logical size by 1
+    /// @return The value previously at the back
+    [[nodiscard]] T pop_back() {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop back");
+        T val = std::move(*this->slot(this->_current_size - 1));
+        this->destroy_from(this->_current_size - 1);
+        return val;
+    }
+
+    /// @brief Remove a value from the front of the small vector, decreasing the logical size by 1
+    /// @return The value previously at the front
+    /// @warning Shifts every value to the left: could be costly for large vectors
+    [[nodiscard]] T pop_front() {
+        fixed_vector_detail::check<Policy>(this->_current_size == 0, fixed_vector_error::empty, "Cannot pop front");
+        T val = std::move(*this->slot(0));
+        this->unsafe_left_shift(0, 1);
+        return val;
+    }
+
+    /// @brief Reverse the small vector contents in-place
+    void reverse() { std::reverse(this->begin(), this->end()); }
+
+    /// @brief Allow square-bracket indexing like a `std::vector`
+    T& operator[](size_t pos) {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->_current_size);
+        return *this->slot(pos);
+    }
+
+    /// @brief Allow const square-bracket indexing like a `std::vector`
+    const T& operator[](size_t pos) const {
+        fixed_vector_detail::check<Policy>(pos >= this->_current_size, fixed_vector_error::out_of_range,
+                                           "Cannot access", pos, this->_current_size);
+        return *this->slot(pos);
+    }
+
+    /// @brief Allow two `small_vector`s to be compared using `==`
+    bool operator== (const small_vector& v) const noexcept {
+        return this->_current_size == v._current_size && std::equal(this->cbegin(), this->cend(), v.cbegin());
+    }
+
+    /// @brief Get mutable iterator to beginning
+    iterator begin() { return this->_data; }
+
+    /// @brief Get mutable iterator to end
+    iterator end() { return this->_data + this->_current_size; }
+
+    /// @brief Get const iterator to beginning
+    const_iterator cbegin() const { return this->_data; }
+
+    /// @brief Get const iterator to end
+    const_iterator cend() const { return this->_data + this->_current_size; }
+
+    /// @brief Overload for getting const iterator to beginning
+    const_iterator begin() const { return cbegin(); }
+
+    /// @brief Overload for getting const iterator to end
+    const_iterator end() const { return cend(); }
+
+    /// @brief Get mutable reverse iterator to the last element
+    reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+
+    /// @brief Get mutable reverse iterator to before the first element
+    reverse_iterator rend() { return reverse_iterator(this->begin()); }
+
+    /// @brief Get const reverse iterator to the last element
+    const_reverse_iterator crbegin() const { return const_reverse_iterator(this->cend()); }
+
+    /// @brief Get const reverse iterator to before the first element
+    const_reverse_iterator crend() const { return const_reverse_iterator(this->cbegin()); }
+
+    /// @brief Overload for getting const reverse iterator to the last element
+    const_reverse_iterator rbegin() const { return crbegin(); }
+
+    /// @brief Overload for getting const reverse iterator to before the first element
+    const_reverse_iterator rend() const { return crend(); }
+};
+
+#endif //SMALL_VECTOR_HPP
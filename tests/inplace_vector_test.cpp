@@ -0,0 +1,268 @@
+//
+// Created by cain986 on 8/13/24.
+//
+
+// Conformance checks for `inplace_vector` against the P0843 `std::inplace_vector` specification
+
+#include "inplace_vector.hpp"
+
+#include <cstdio>
+#include <list>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define CHECK(cond)                                                                                 \
+    do {                                                                                            \
+        if (!(cond)) {                                                                              \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond);           \
+            ++failures;                                                                             \
+        }                                                                                           \
+    } while (0)
+
+static int failures = 0;
+
+/// @brief An element whose constructions can be made to throw after a budget runs out, and that counts live objects
+struct counted {
+    static inline int live = 0;
+    static inline int budget = 1000000;
+
+    int value;
+
+    counted(int v = 0) : value(v) { this->take(); }
+    counted(const counted& c) : value(c.value) { this->take(); }
+    counted(counted&& c) noexcept : value(c.value) { ++live; }
+    counted& operator= (const counted&) = default;
+    counted& operator= (counted&&) = default;
+    ~counted() { --live; }
+
+    bool operator== (const counted& c) const { return this->value == c.value; }
+
+private:
+    void take() {
+        if (--budget < 0) throw 42;
+        ++live;
+    }
+};
+
+/*
+ * Triviality: the special members are trivial exactly when they are for `T`
+ */
+static_assert(std::is_trivially_copyable_v<inplace_vector<int, 8>>);
+static_assert(std::is_trivially_copy_constructible_v<inplace_vector<int, 8>>);
+static_assert(std::is_trivially_move_constructible_v<inplace_vector<int, 8>>);
+static_assert(std::is_trivially_copy_assignable_v<inplace_vector<int, 8>>);
+static_assert(std::is_trivially_move_assignable_v<inplace_vector<int, 8>>);
+static_assert(std::is_trivially_destructible_v<inplace_vector<int, 8>>);
+static_assert(!std::is_trivially_copyable_v<inplace_vector<std::string, 8>>);
+static_assert(!std::is_trivially_destructible_v<inplace_vector<std::string, 8>>);
+static_assert(std::is_nothrow_move_constructible_v<inplace_vector<std::string, 8>>);
+static_assert(!std::is_copy_constructible_v<inplace_vector<std::unique_ptr<int>, 8>>);
+
+/*
+ * Member types and capacity
+ */
+static_assert(std::is_same_v<inplace_vector<int, 8>::size_type, size_t>);
+static_assert(std::ranges::contiguous_range<inplace_vector<int, 8>>);
+static_assert(inplace_vector<int, 8>::capacity() == 8 && inplace_vector<int, 8>::max_size() == 8);
+
+/*
+ * Constant evaluation
+ */
+constexpr bool constexpr_usable() {
+    inplace_vector<int, 8> v{3, 1, 2};
+    v.insert(v.begin() + 1, {7, 8});
+    v.erase(v.begin());
+    int more[] = {5, 6};
+    v.append_range(more);
+    v.resize(4);
+    return v.size() == 4 && v[0] == 7 && v[3] == 2 && v.try_append_range(more) == std::end(more);
+}
+static_assert(constexpr_usable());
+
+static void test_try_and_unchecked() {
+    inplace_vector<int, 2> v;
+    CHECK(v.try_push_back(1) != nullptr);
+    CHECK(*v.try_emplace_back(2) == 2);
+    CHECK(v.try_push_back(3) == nullptr);
+    CHECK(v.try_emplace_back(3) == nullptr);
+    CHECK(v.size() == 2);
+
+    std::string s = "kept";
+    inplace_vector<std::string, 1> full{"x"};
+    CHECK(full.try_push_back(std::move(s)) == nullptr);
+    CHECK(s == "kept");
+
+    inplace_vector<int, 3> u;
+    CHECK(u.unchecked_push_back(1) == 1);
+    CHECK(u.unchecked_emplace_back(2) == 2);
+    CHECK(&u.unchecked_push_back(3) == &u.back());
+    CHECK(u.size() == 3);
+}
+
+static void test_append_range() {
+    inplace_vector<int, 4> v{1};
+    std::vector<int> two{2, 3};
+    v.append_range(two);
+    CHECK(v.size() == 3 && v[2] == 3);
+
+    bool threw = false;
+    try {
+        v.append_range(two);
+    } catch (const std::bad_alloc&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(v.size() == 3);
+
+    // try_append_range appends what fits and returns where it stopped
+    std::list<int> src{7, 8, 9};
+    auto rest = v.try_append_range(src);
+    CHECK(v.size() == 4 && v[3] == 7);
+    CHECK(rest == std::next(src.begin()));
+
+    inplace_vector<int, 4> w;
+    CHECK(w.try_append_range(src) == src.end());
+    CHECK(w.size() == 3);
+}
+
+static void test_resize() {
+    inplace_vector<std::string, 4> v{"a"};
+    v.resize(3);
+    CHECK(v.size() == 3 && v[0] == "a" && v[2].empty());
+    v.resize(4, "z");
+    CHECK(v[3] == "z");
+    v.resize(1);
+    CHECK(v.size() == 1 && v[0] == "a");
+
+    bool threw = false;
+    try {
+        v.resize(5);
+    } catch (const std::bad_alloc&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(v.size() == 1);
+}
+
+static void test_overflow_throws_bad_alloc() {
+    inplace_vector<int, 2> v{1, 2};
+    int thrown = 0;
+    try { v.push_back(3); } catch (const std::bad_alloc&) { ++thrown; }
+    try { v.emplace_back(3); } catch (const std::bad_alloc&) { ++thrown; }
+    try { v.insert(v.begin(), 3); } catch (const std::bad_alloc&) { ++thrown; }
+    try { v.insert(v.begin(), 2, 3); } catch (const std::bad_alloc&) { ++thrown; }
+    try { inplace_vector<int, 2>::reserve(3); } catch (const std::bad_alloc&) { ++thrown; }
+    try { inplace_vector<int, 2> w{1, 2, 3}; } catch (const std::bad_alloc&) { ++thrown; }
+    try { inplace_vector<int, 2> w(3); } catch (const std::bad_alloc&) { ++thrown; }
+    CHECK(thrown == 7);
+    CHECK(v.size() == 2 && v[0] == 1 && v[1] == 2);
+
+    bool out_of_range = false;
+    try {
+        (void)v.at(2);
+    } catch (const std::out_of_range&) {
+        out_of_range = true;
+    }
+    CHECK(out_of_range);
+}
+
+static void test_range_insert() {
+    inplace_vector<std::string, 8> v{"a", "d"};
+    std::vector<std::string> mid{"b", "c"};
+    auto it = v.insert(v.begin() + 1, mid.begin(), mid.end());
+    CHECK(it == v.begin() + 1);
+    CHECK(v.size() == 4 && v[1] == "b" && v[2] == "c" && v[3] == "d");
+
+    std::list<std::string> tail{"e", "f"};
+    v.insert_range(v.end(), tail);
+    CHECK(v.size() == 6 && v[5] == "f");
+
+    // Single-pass input ranges are inserted too
+    std::istringstream words("x y");
+    v.insert(v.begin(), std::istream_iterator<std::string>(words), std::istream_iterator<std::string>());
+    CHECK(v.size() == 8 && v[0] == "x" && v[1] == "y" && v[2] == "a");
+
+    // Inserting copies of an element of the vector itself
+    inplace_vector<std::string, 8> w{"p", "q"};
+    w.insert(w.begin(), 2, w[1]);
+    CHECK(w.size() == 4 && w[0] == "q" && w[1] == "q" && w[2] == "p");
+}
+
+static void test_range_insert_rollback() {
+    {
+        inplace_vector<counted, 8> v{1, 2, 3};
+        const int before = counted::live;
+        counted src[3] = {7, 8, 9};
+        counted::budget = 1;
+        bool threw = false;
+        try {
+            v.insert(v.begin() + 1, src, src + 3);
+        } catch (int) {
+            threw = true;
+        }
+        counted::budget = 1000000;
+        CHECK(threw);
+        CHECK(v.size() == 3 && v[0].value == 1 && v[1].value == 2 && v[2].value == 3);
+        CHECK(counted::live == before + 3);
+    }
+    CHECK(counted::live == 0);
+
+    // Overflowing a single-pass range leaves the vector as it was
+    inplace_vector<std::string, 3> v{"a"};
+    std::istringstream words("x y z");
+    bool threw = false;
+    try {
+        v.insert(v.begin(), std::istream_iterator<std::string>(words), std::istream_iterator<std::string>());
+    } catch (const std::bad_alloc&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(v.size() == 1 && v[0] == "a");
+}
+
+static void test_constructor_rollback() {
+    std::list<counted> src(3, counted(1));
+    const int before = counted::live;
+    counted::budget = 2;
+    bool threw = false;
+    try {
+        inplace_vector<counted, 8> v(src.begin(), src.end());
+    } catch (int) {
+        threw = true;
+    }
+    counted::budget = 1000000;
+    CHECK(threw);
+    CHECK(counted::live == before);
+}
+
+static void test_erase_and_compare() {
+    inplace_vector<int, 8> v{1, 2, 3, 2, 5};
+    CHECK(erase(v, 2) == 2);
+    CHECK(erase_if(v, [](int x) { return x > 4; }) == 1);
+    CHECK((v == inplace_vector<int, 8>{1, 3}));
+    CHECK((inplace_vector<int, 8>{1, 2} < inplace_vector<int, 8>{1, 3}));
+
+    inplace_vector<int, 8> w{9};
+    swap(v, w);
+    CHECK(v.size() == 1 && w.size() == 2);
+}
+
+int main() {
+    test_try_and_unchecked();
+    test_append_range();
+    test_resize();
+    test_overflow_throws_bad_alloc();
+    test_range_insert();
+    test_range_insert_rollback();
+    test_constructor_rollback();
+    test_erase_and_compare();
+    if (failures != 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("inplace_vector: all checks passed");
+    return 0;
+}